@@ -7,16 +7,31 @@ namespace vk
         std::vector<const char*> instanceExtensions,
         std::vector<const char*> deviceExtensions)
     {
+        useExtendedDynamicState = true;
         if (!InitVulkan(windowParams, validationLayer, instanceExtensions, deviceExtensions, nullptr,
             false, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT))
         {
             return false;
         }
 
-        //load texture data
+        //texture decode and mesh parsing are independent, so they run as jobs next to each other
         std::vector<unsigned char> imageData;
         int imageW, imageH, nrChannels, dataSize;
-        if (!LoadTextureDataFromFile("textures/normal_map.png", 4, imageData, &imageW, &imageH, &nrChannels, &dataSize))
+        bool textureLoaded = false;
+        bool meshLoaded = false;
+        JobCounter loading;
+        SubmitJob(jobSystem, [&](uint32_t)
+        {
+            textureLoaded = LoadTextureDataFromFile("textures/normal_map.png", 4, imageData, &imageW, &imageH,
+                &nrChannels, &dataSize);
+        }, &loading);
+        SubmitJob(jobSystem, [&](uint32_t)
+        {
+            meshLoaded = MeshLoader::LoadMesh("models/ice.obj", true, true, true, true, model);
+        }, &loading);
+        WaitForJobCounter(jobSystem, loading);
+
+        if (!textureLoaded || !meshLoaded)
         {
             return false;
         }
@@ -43,10 +58,9 @@ namespace vk
             &imageData[0], normalTexture, subresourceLayer, { 0,0,0 }, { (uint32_t)imageW, (uint32_t)imageH, 1 },
             VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, VK_ACCESS_SHADER_READ_BIT,
             VK_IMAGE_ASPECT_COLOR_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-            graphicsQueue.handle, frameResources.front().commandBuffer, {});
+            graphicsQueue.handle, setupCommandBuffer, {});
    
-        //load mesh data to memory
-        MeshLoader::LoadMesh("models/ice.obj", true, true, true, true, model);
+        //upload mesh data
         VkDeviceSize vertexBufferSize = sizeof(model.data[0]) * model.data.size();
         CreateBuffer(device, vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
             vertexBuffer);
@@ -56,18 +70,21 @@ namespace vk
         UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound(device, physicalDevice, vertexBufferSize,
             &model.data[0], vertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-            graphicsQueue.handle, frameResources.front().commandBuffer, {});
+            graphicsQueue.handle, setupCommandBuffer, {});
 
-        //load matrix data throught staging buffer into uniform buffer
-        VkDeviceSize uniformBufferSize = sizeof(UniformBufferObject);
-        CreateBuffer(device, uniformBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, stagingBuffer);
-        AllocateAndBindMemoryObjectToBuffer(device, physicalDevice, stagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-            stagingBufferMemory);
+        //matrices are written straight into a persistently mapped ring, one region per frame in flight
+        if (!CreateUniformRing(device, physicalDevice, sizeof(UniformBufferObject), framesCount, uniformRing))
+        {
+            return false;
+        }
 
-        CreateUniformBuffer(device, physicalDevice, uniformBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, uniformBuffer, uniformBufferMemory);
+        //every part becomes one indirect record, rewritten each frame into that frame's region
+        if (!CreateLinearAllocator(device, physicalDevice, sizeof(VkDrawIndirectCommand) * model.meshes.size(),
+            framesCount, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, indirectAllocator))
+        {
+            return false;
+        }
 
-        updateUniformBuffer = true;
         glm::mat4 modelMatrix = glm::mat4(1.0f);
         glm::mat4 viewMatrix = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), 
             glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
@@ -82,15 +99,12 @@ namespace vk
             projectionMatrix
         };
 
-        MapUpdateAndUnmapHostVisibleMemory(device, stagingBufferMemory, 0, uniformBufferSize,
-            &uniformObject, true, nullptr);
-
         //descriptor set with uniform buffer
         std::vector<VkDescriptorSetLayoutBinding> descriptorLayoutBindings =
         {
             {
                 0,
-                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
                 1,
                 VK_SHADER_STAGE_VERTEX_BIT,
                 nullptr
@@ -104,130 +118,72 @@ namespace vk
             }
         };
 
-        CreateDescriptorSetLayout(device, descriptorLayoutBindings, descriptorSetLayout);
+        GetOrCreateDescriptorSetLayout(device, descriptorLayoutCache, 0, descriptorLayoutBindings, descriptorSetLayout);
 
-        std::vector<VkDescriptorPoolSize> descriptorPoolSize =
+        std::vector<DescriptorPoolRatio> descriptorRatios =
         {
-            {  
-                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                1
-            },
-            {
-                VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                1
-            },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1.0f },
         };
 
-        CreateDescriptorPool(device, false, 1, descriptorPoolSize, descriptorPool);
-        AllocateDescriptorSets(device, descriptorPool, { descriptorSetLayout }, descriptorSets);
-
-        VkDescriptorBufferInfo bufferInfo =
+        CreateDescriptorAllocator(device, 4, descriptorRatios, descriptorAllocator);
+        if (!AllocateDescriptorSetsFromAllocator(device, descriptorAllocator, { descriptorSetLayout }, descriptorSets))
         {
-            uniformBuffer,
-            0,
-            VK_WHOLE_SIZE
-        };
-
-        BufferDescriptorInfo bufferDescriptorUpdate =
-        {
-            descriptorSets[0],
-            0,
-            0,
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            { bufferInfo }
-        };
-
-        VkDescriptorImageInfo imageInfo =
-        {
-            normalSampler,
-            normalTextureView, 
-            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-        };
+            return false;
+        }
 
-        ImageDescriptorInfo imageDescriptorInfo =
+        //the template writes both bindings from one packed struct
+        VkDescriptorUpdateTemplate updateTemplate;
+        if (!GetOrCreateDescriptorUpdateTemplate(device, descriptorLayoutCache, descriptorLayoutBindings,
+            descriptorSetLayout, updateTemplate))
         {
-            descriptorSets[0],
-            1, 
-            0,
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            {imageInfo}
-        };
-
-        UpdateDescriptorSets(device, { imageDescriptorInfo }, { bufferDescriptorUpdate }, {}, {});
+            return false;
+        }
 
-        //RenderPass
-        std::vector<VkAttachmentDescription> attachmentDescriptions =
+        BumpMappingDescriptors descriptorData =
         {
             {
+                uniformRing.storage.buffer,
                 0,
-                swapchain.format,
-                VK_SAMPLE_COUNT_1_BIT,
-                VK_ATTACHMENT_LOAD_OP_CLEAR,
-                VK_ATTACHMENT_STORE_OP_STORE,
-                VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-                VK_ATTACHMENT_STORE_OP_DONT_CARE,
-                VK_IMAGE_LAYOUT_UNDEFINED,
-                VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+                sizeof(UniformBufferObject)
             },
             {
-                0,
-                depthFormat,
-                VK_SAMPLE_COUNT_1_BIT,
-                VK_ATTACHMENT_LOAD_OP_CLEAR,
-                VK_ATTACHMENT_STORE_OP_DONT_CARE,
-                VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-                VK_ATTACHMENT_STORE_OP_DONT_CARE,
-                VK_IMAGE_LAYOUT_UNDEFINED,
-                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
-            },
+                normalSampler,
+                normalTextureView,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            }
         };
 
-        VkAttachmentReference depthAttachment = 
-        {
-            1,
-            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
-        };
-        VkAttachmentReference colorAttachment = 
-        {
-            0,
-            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-        };
+        UpdateDescriptorSetWithTemplate(device, descriptorSets[0], updateTemplate, &descriptorData);
 
-        std::vector<SubpassParams> subpassParams = 
-        {
-            {
-                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                {},
-                {colorAttachment},
-                {},
-                &depthAttachment,
-                {},
-            },
-        };
+        //the main pass renders into the swapchain image through the render graph, which also owns the depth buffer
+        renderGraph = {};
+        backbuffer = ImportRenderGraphImage(renderGraph, "backbuffer",
+            { swapchain.format, swapchain.size, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_ASPECT_COLOR_BIT },
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+        uint32_t depth = AddRenderGraphImage(renderGraph, "depth",
+            { depthFormat, swapchain.size, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_ASPECT_DEPTH_BIT });
 
-        std::vector<VkSubpassDependency> subpassDependencies =
-        {
+        uint32_t mainPass = AddRenderGraphPass(renderGraph, "main", VK_PIPELINE_BIND_POINT_GRAPHICS,
+            [this](VkCommandBuffer commandBuffer)
             {
-                VK_SUBPASS_EXTERNAL,
-                0,
-                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                VK_ACCESS_MEMORY_READ_BIT,
-                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-                VK_DEPENDENCY_BY_REGION_BIT
-            },
-            {
-                0,
-                VK_SUBPASS_EXTERNAL,
-                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-                VK_ACCESS_MEMORY_READ_BIT,
-                VK_DEPENDENCY_BY_REGION_BIT
-            },
-        };
-
-        CreateRenderPass(device, attachmentDescriptions, subpassParams, subpassDependencies, renderPass);
+                RecordMainPass(commandBuffer);
+            });
+
+        VkClearValue colorClear = {};
+        colorClear.color = { { 0.1f, 0.2f, 0.3f, 1.0f } };
+        VkClearValue depthClear = {};
+        depthClear.depthStencil = { 1.0f, 0 };
+        UseRenderGraphAttachment(renderGraph, mainPass, backbuffer, RENDER_GRAPH_USAGE_COLOR_ATTACHMENT,
+            VK_ATTACHMENT_LOAD_OP_CLEAR, colorClear);
+        UseRenderGraphAttachment(renderGraph, mainPass, depth, RENDER_GRAPH_USAGE_DEPTH_ATTACHMENT,
+            VK_ATTACHMENT_LOAD_OP_CLEAR, depthClear);
+
+        if (!CompileRenderGraph(device, physicalDevice, renderGraph) ||
+            !GetRenderGraphPassRenderPass(renderGraph, mainPass, renderPass, mainSubpass))
+        {
+            return false;
+        }
 
         //graphics pipeline
         std::vector<VkPushConstantRange> range = 
@@ -240,39 +196,87 @@ namespace vk
         };
 
         std::vector<VkDescriptorSetLayout> descriptorLayouts = { descriptorSetLayout };
-        CreatePipelineLayout(device, descriptorLayouts, range, pipelineLayout);
+        GetOrCreatePipelineLayout(device, descriptorLayoutCache, descriptorLayouts, range, pipelineLayout);
          
-        std::vector<unsigned char> vertexShader;
-        if (!GetBinaryFileContents("shaders/BumpMapping/shaderSPIRV.vert.txt", vertexShader))
+        if (!LoadShaderModuleFromSource(device, "shaders/BumpMapping/shader.vert", VK_SHADER_STAGE_VERTEX_BIT, {},
+            "shaders/cache", "shaders/BumpMapping/shaderSPIRV.vert.txt", vertexShaderModule))
+        {
+            return false;
+        }
+
+        if (!LoadShaderModuleFromSource(device, "shaders/BumpMapping/shader.frag", VK_SHADER_STAGE_FRAGMENT_BIT, {},
+            "shaders/cache", "shaders/BumpMapping/shaderSPIRV.frag.txt", fragmentShaderModule))
         {
             return false;
         }
 
-        VkShaderModule vertexShaderModule;
-        CreateShaderModule(device, vertexShader, vertexShaderModule);
+        //fragment shader variant: specular exponent and normal mapping switch
+        float specularExponent = 32.0f;
+        VkBool32 useNormalMap = VK_TRUE;
+        AddSpecializationConstant(0, &specularExponent, sizeof(specularExponent), fragmentConstants);
+        AddSpecializationConstant(1, &useNormalMap, sizeof(useNormalMap), fragmentConstants);
+        SpecifySpecializationInfo(fragmentConstants);
+
+        VkBool32 useFlatNormals = VK_FALSE;
+        AddSpecializationConstant(0, &specularExponent, sizeof(specularExponent), flatFragmentConstants);
+        AddSpecializationConstant(1, &useFlatNormals, sizeof(useFlatNormals), flatFragmentConstants);
+        SpecifySpecializationInfo(flatFragmentConstants);
+
+        BumpMappingPipelineTarget pipelineTarget =
+        {
+            renderPass,
+            mainSubpass,
+            pipelineLayout,
+            swapchain.size,
+            dynamicStateSupport.extendedDynamicState
+        };
 
-        std::vector<unsigned char> fragmentShader;
-        if (!GetBinaryFileContents("shaders/BumpMapping/shaderSPIRV.frag.txt", fragmentShader))
+        std::vector<unsigned char> cacheData;
+        CreatePipelineRegistry(device, cacheData, pipelineRegistry);
+        std::vector<RegisteredPipeline> variants;
+        if (!CreatePipelines(pipelineTarget, vertexShaderModule, fragmentShaderModule, true, variants))
         {
             return false;
         }
+        pipeline = variants[0].pipeline;
+        flatPipeline = variants[1].pipeline;
+
+        //rebuild both variants on a background thread whenever a shader source changes, against a copy of the
+        //render pass state taken before the thread starts, viewport and scissor are dynamic so resizes do not matter
+        std::string shaderDirectory = GetShaderSourceDirectory();
+        uint32_t program = AddShaderHotReloadProgram(shaderHotReload,
+            [this, pipelineTarget](const std::vector<VkShaderModule>& modules, std::vector<RegisteredPipeline>& newPipelines)
+            {
+                return CreatePipelines(pipelineTarget, modules[0], modules[1], false, newPipelines);
+            }, { &pipeline, &flatPipeline });
+        WatchShaderForHotReload(shaderHotReload, program, shaderDirectory + "/BumpMapping/shader.vert",
+            VK_SHADER_STAGE_VERTEX_BIT, {}, &vertexShaderModule);
+        WatchShaderForHotReload(shaderHotReload, program, shaderDirectory + "/BumpMapping/shader.frag",
+            VK_SHADER_STAGE_FRAGMENT_BIT, {}, &fragmentShaderModule);
+        StartShaderHotReload(device, &pipelineRegistry, "shaders/cache", shaderHotReload);
 
-        VkShaderModule fragmentShaderModule;
-        CreateShaderModule(device, fragmentShader, fragmentShaderModule);
+        return true;
+    }
 
+    bool BumpMappingSample::CreatePipelines(const BumpMappingPipelineTarget& target,
+        VkShaderModule vertexModule,
+        VkShaderModule fragmentModule,
+        bool registerPipelines,
+        std::vector<RegisteredPipeline>& pipelines)
+    {
         std::vector<ShaderStageParams> shaderStageParams =
         {
             {
                 VK_SHADER_STAGE_VERTEX_BIT,
-                vertexShaderModule,
+                vertexModule,
                 "main",
                 nullptr
             },
             {
                 VK_SHADER_STAGE_FRAGMENT_BIT,
-                fragmentShaderModule,
+                fragmentModule,
                 "main",
-                nullptr
+                &fragmentConstants.info
             },
         };
 
@@ -337,14 +341,14 @@ namespace vk
         VkViewport viewport = {
             0.0f,
             0.0f,
-            static_cast<float>(swapchain.size.width),
-            static_cast<float>(swapchain.size.height),
+            static_cast<float>(target.size.width),
+            static_cast<float>(target.size.height),
             0.0f,
             1.0f,
         };
 
         VkOffset2D offset = { 0, 0 };
-        VkRect2D rect = { offset, swapchain.size };
+        VkRect2D rect = { offset, target.size };
 
         ViewportInfo viewportInfo =
         {
@@ -391,56 +395,138 @@ namespace vk
             VK_DYNAMIC_STATE_SCISSOR,
         };
 
+        //rasterization and depth state are set while recording, so one pipeline serves all their combinations
+        if (target.extendedDynamicState)
+        {
+            dynamicStates.insert(dynamicStates.end(), {
+                VK_DYNAMIC_STATE_CULL_MODE,
+                VK_DYNAMIC_STATE_FRONT_FACE,
+                VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY,
+                VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE,
+                VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE,
+                VK_DYNAMIC_STATE_DEPTH_COMPARE_OP,
+            });
+        }
+
         VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo;
         SpecifyPipelineDynamicStates(dynamicStates, dynamicStateCreateInfo);
 
         VkGraphicsPipelineCreateInfo pipelineCreateInfo;
         SpecifyGraphicsPipelineParameters(0, shaderStageInfos, vertexInputStateCreateInfo, assemblyStateCreateInfo,
             nullptr, &viewportStateCreateInfo, resterizationStateCreateInfo, &multisampleStateCreateInfo, &depthStencilStateCreateInfoInfo,
-            &blendStateCreateInfo, &dynamicStateCreateInfo, pipelineLayout, renderPass, 0, VK_NULL_HANDLE, -1, pipelineCreateInfo);
+            &blendStateCreateInfo, &dynamicStateCreateInfo, target.pipelineLayout, target.renderPass, target.subpass, VK_NULL_HANDLE, -1, pipelineCreateInfo);
 
-        std::vector<VkPipeline> pipelines;
-        CreateGraphicsPipelines(device, {pipelineCreateInfo}, VK_NULL_HANDLE, pipelines);
-        pipeline = pipelines[0];
+        //the variant without normal mapping differs only in specialization, so both are created as one family
+        std::vector<VkPipelineShaderStageCreateInfo> flatShaderStageInfos = shaderStageInfos;
+        flatShaderStageInfos[1].pSpecializationInfo = &flatFragmentConstants.info;
+        VkGraphicsPipelineCreateInfo flatPipelineCreateInfo = pipelineCreateInfo;
+        flatPipelineCreateInfo.pStages = flatShaderStageInfos.data();
+
+        std::vector<VkGraphicsPipelineCreateInfo> variantsInfo = { pipelineCreateInfo, flatPipelineCreateInfo };
+        std::vector<VkPipeline> variants;
+        if (registerPipelines)
+        {
+#ifdef VK_MEASURE_PIPELINE_CREATION
+            //creates every variant twice more without a cache, so it is only done when asked for
+            PipelineCreationTimings timings;
+            MeasurePipelineFamilyCreation(device, variantsInfo, timings);
+#endif
+
+            if (!CreateGraphicsPipelineFamily(device, pipelineRegistry, variantsInfo, variants))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            //hot reloaded variants are registered by the render thread once they are swapped in
+            CreateGraphicsPipelines(device, variantsInfo, pipelineRegistry.cache, variants);
+            if (variants[0] == VK_NULL_HANDLE || variants[1] == VK_NULL_HANDLE)
+            {
+                DestroyPipeline(device, variants[0]);
+                DestroyPipeline(device, variants[1]);
+                return false;
+            }
+        }
 
+        pipelines.clear();
+        for (size_t i = 0; i < variants.size(); i++)
+        {
+            pipelines.push_back(GetRegisteredPipeline(variantsInfo[i], variants[i]));
+        }
         return true;
     }
 
+    void BumpMappingSample::RecordMainPass(VkCommandBuffer commandBuffer)
+    {
+        VkViewport viewport = {
+            0.0f,
+            0.0f,
+            static_cast<float>(swapchain.size.width),
+            static_cast<float>(swapchain.size.height),
+            0.0f,
+            1.0f,
+        };
+
+        SetViewportStateDynamically(commandBuffer, 0, { viewport });
+
+        VkOffset2D scissor = { 0, 0 };
+        VkRect2D rect = { scissor, swapchain.size };
+        SetScissorsStateDynamically(commandBuffer, 0, { rect });
+
+        if (dynamicStateSupport.extendedDynamicState)
+        {
+            SetCullModeDynamically(commandBuffer, VK_CULL_MODE_BACK_BIT);
+            SetFrontFaceDynamically(commandBuffer, VK_FRONT_FACE_COUNTER_CLOCKWISE);
+            SetPrimitiveTopologyDynamically(commandBuffer, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+            SetDepthTestEnableDynamically(commandBuffer, true);
+            SetDepthWriteEnableDynamically(commandBuffer, true);
+            SetDepthCompareOpDynamically(commandBuffer, VK_COMPARE_OP_LESS_OR_EQUAL);
+        }
+
+        //the parts share all of their state, so the recorder binds it once for the whole mesh
+        ResetDrawList(drawList);
+        uint32_t material = AddDrawMaterial(drawList, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
+            descriptorSets, { uniformOffset });
+
+        std::array<float, 8> lightAndViewPosition = { 0.0, 0.0, 1.0f, 0.0f, 0.0f, 0.0f, 3.0f, 0.0f };
+        for (auto& part : model.meshes)
+        {
+            DrawPacket packet = {};
+            packet.sortKey = MakeDrawSortKey(0, 0, material, 0.0f);
+            packet.pipeline = drawNormalMapped ? pipeline : flatPipeline;
+            packet.material = material;
+            packet.vertexBuffer = vertexBuffer;
+            packet.pushConstantStages = VK_SHADER_STAGE_VERTEX_BIT;
+            packet.pushConstantSize = sizeof(float) * 8;
+            packet.count = part.vertexCount;
+            packet.instanceCount = 1;
+            packet.first = part.vertexOffset;
+            AddDrawPacket(drawList, packet, lightAndViewPosition.data());
+        }
+        SortDrawList(drawList);
+
+        BeginLinearAllocatorFrame(indirectAllocator, frameScheduler.frameIndex);
+        DrawRecorder recorder;
+        BeginDrawRecorder(commandBuffer, recorder);
+        RecordDrawListIndirect(recorder, descriptorLayoutCache, drawList, indirectAllocator);
+        FlushLinearAllocatorFrame(device, indirectAllocator);
+    }
+
     bool BumpMappingSample::Draw()
     {
+        ApplyShaderHotReload(frameScheduler, shaderHotReload);
+
         auto recordCommandBuffer = [&](VkCommandBuffer commandBuffer, uint32_t imageIndex, VkFramebuffer framebuffer)
         {
             BeginCommandBufferRecordingOperation(commandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr);
 
-            if (updateUniformBuffer)
+            BeginUniformRingFrame(uniformRing, frameScheduler.frameIndex);
+            if (!PushUniformData(uniformRing, &uniformObject, sizeof(uniformObject), uniformOffset))
             {
-                BufferTransition preTransition =
-                {
-                    uniformBuffer,
-                    VK_ACCESS_UNIFORM_READ_BIT,
-                    VK_ACCESS_TRANSFER_WRITE_BIT,
-                    VK_QUEUE_FAMILY_IGNORED,
-                    VK_QUEUE_FAMILY_IGNORED,
-                };
-                SetBufferMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
-                    VK_PIPELINE_STAGE_TRANSFER_BIT, { preTransition });
-                VkBufferCopy region = {
-                    0, 0, sizeof(uniformObject)
-                };
-                std::vector<VkBufferCopy> regions = { region };
-                CopyDataBetweenBuffers(commandBuffer, stagingBuffer, uniformBuffer, regions);
-
-                BufferTransition postTransition =
-                {
-                    uniformBuffer,
-                    VK_ACCESS_TRANSFER_WRITE_BIT,
-                    VK_ACCESS_UNIFORM_READ_BIT,
-                    VK_QUEUE_FAMILY_IGNORED,
-                    VK_QUEUE_FAMILY_IGNORED,
-                };
-                SetBufferMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, { postTransition });
+                return false;
             }
+            FlushUniformRingFrame(device, uniformRing);
 
             if (presentQueue.familyIndex != graphicsQueue.familyIndex)
             {
@@ -460,40 +546,9 @@ namespace vk
                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, { transitionBeforeDrawing });
             }
 
-            BeginRenderPass(commandBuffer, renderPass, framebuffer, { {0,0}, swapchain.size },
-                { {0.1f, 0.2f, 0.3f, 1.0f}, {1.0f, 0} }, VK_SUBPASS_CONTENTS_INLINE);
-
-            VkViewport viewport = {
-                0.0f,
-                0.0f,
-                static_cast<float>(swapchain.size.width),
-                static_cast<float>(swapchain.size.height),
-                0.0f,
-                1.0f,
-            };
-
-            SetViewportStateDynamically(commandBuffer, 0, { viewport });
-
-            VkOffset2D scissor = { 0, 0 };
-            VkRect2D rect = { scissor, swapchain.size };
-            SetScissorsStateDynamically(commandBuffer, 0, { rect });
-
-            BindVertexBuffers(commandBuffer, 0, { {vertexBuffer, 0} });
-
-            BindDescitorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, descriptorSets, {});
-
-            BindPipelineObject(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-
-            std::array<float, 8> lightAndViewPosition = { 0.0, 0.0, 1.0f, 0.0f, 0.0f, 0.0f, 3.0f, 0.0f };
-            ProvidePushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(float) * 8,
-                &lightAndViewPosition[0]);
-
-            for (size_t i = 0; i < model.meshes.size(); i++)
-            {
-                DrawGeometry(commandBuffer, model.meshes[i].vertexCount, 1, model.meshes[i].vertexOffset, 0);
-            }
-
-            EndRenderPass(commandBuffer);
+            //the compiled graph stays the same, only the swapchain image it renders into changes
+            SetRenderGraphImportedImage(renderGraph, backbuffer, swapchain.images[imageIndex], swapchain.imageViews[imageIndex]);
+            ExecuteRenderGraph(device, commandBuffer, renderGraph);
 
             if (presentQueue.familyIndex != graphicsQueue.familyIndex)
             {
@@ -517,14 +572,22 @@ namespace vk
             return true;
         };
 
-        std::vector<WaitSemaphoreInfo> waitInfos;
-        IncreasePerformanceThroughtIncreasingTheNumberOfSeparatelyRenderedFrames(device, graphicsQueue.handle,
-            presentQueue.handle, swapchain.handle, swapchain.size, swapchain.imageViews,
-            renderPass, waitInfos, recordCommandBuffer, frameResources);
+        RenderScheduledFrame(device, frameScheduler, presentQueue.handle, swapchain.handle, swapchain.size,
+            swapchain.imageViews, VK_NULL_HANDLE, {}, recordCommandBuffer, frameResources);
 
         return true;
     }
 
+    void BumpMappingSample::MouseClick(size_t button,
+        bool state)
+    {
+        //left click switches between the normal mapped and the flat variant of the pipeline family
+        if (button == 0 && state)
+        {
+            drawNormalMapped = !drawNormalMapped;
+        }
+    }
+
     bool BumpMappingSample::Resize()
     {
         return true;
@@ -533,5 +596,21 @@ namespace vk
     void BumpMappingSample::Destroy()
     {
         WaitForAllSumbittedCommandsToBeFinished(device);
+        StopShaderHotReload(shaderHotReload);
+        DestroyShaderModule(device, vertexShaderModule);
+        DestroyShaderModule(device, fragmentShaderModule);
+        DestroyPipelineRegistry(device, pipelineRegistry);
+        DestroyDescriptorAllocator(device, descriptorAllocator);
+        DestroyDescriptorLayoutCache(device, descriptorLayoutCache);
+        DestroyUniformRing(device, uniformRing);
+        DestroyLinearAllocator(device, indirectAllocator);
+        DestroyBuffer(device, vertexBuffer);
+        FreeDeviceMemoryObject(device, vertexBufferMemory);
+        DestroySampler(device, normalSampler);
+        DestroyImageView(device, normalTextureView);
+        DestroyImage(device, normalTexture);
+        FreeDeviceMemoryObject(device, normalTextureMemory);
+        DestroyRenderGraph(device, renderGraph);
+        VulkanSample::Destroy();
     }
 }
\ No newline at end of file
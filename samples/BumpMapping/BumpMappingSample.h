@@ -4,6 +4,23 @@
 
 namespace vk
 {
+    //matches the binding order of the descriptor set layout
+    struct BumpMappingDescriptors
+    {
+        VkDescriptorBufferInfo uniformBuffer;
+        VkDescriptorImageInfo normalMap;
+    };
+
+    //state the pipelines are built against, copied so the hot reload thread never reads the sample's members
+    struct BumpMappingPipelineTarget
+    {
+        VkRenderPass renderPass;
+        uint32_t subpass;
+        VkPipelineLayout pipelineLayout;
+        VkExtent2D size;
+        bool extendedDynamicState;
+    };
+
     class BumpMappingSample : public VulkanSample
     {
     public:
@@ -14,26 +31,47 @@ namespace vk
         virtual bool Draw()  override;
         virtual bool Resize()  override;
         virtual void Destroy()  override;
+        virtual void MouseClick(size_t button, bool state) override;
+
+    private:
+        bool CreatePipelines(const BumpMappingPipelineTarget& target,
+            VkShaderModule vertexModule,
+            VkShaderModule fragmentModule,
+            bool registerPipelines,
+            std::vector<RegisteredPipeline>& pipelines);
+
+        void RecordMainPass(VkCommandBuffer commandBuffer);
 
     private:
         Mesh model;
         VkBuffer vertexBuffer;
         VkDeviceMemory vertexBufferMemory;
 
+        DescriptorLayoutCache descriptorLayoutCache;
         VkDescriptorSetLayout descriptorSetLayout;
-        VkDescriptorPool descriptorPool;
+        DescriptorAllocator descriptorAllocator;
         std::vector<VkDescriptorSet> descriptorSets;
+        DrawList drawList;
+        LinearAllocator indirectAllocator;
 
+        RenderGraph renderGraph;
+        uint32_t backbuffer;
         VkRenderPass renderPass;
+        uint32_t mainSubpass;
         VkPipelineLayout pipelineLayout;
         VkPipeline pipeline;
+        PipelineRegistry pipelineRegistry;
+        SpecializationConstants fragmentConstants;
+        SpecializationConstants flatFragmentConstants;
+        VkPipeline flatPipeline;
+        bool drawNormalMapped = true;
+        VkShaderModule vertexShaderModule;
+        VkShaderModule fragmentShaderModule;
+        ShaderHotReload shaderHotReload;
 
-        VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
-        bool updateUniformBuffer;
-        VkBuffer uniformBuffer;
-        VkDeviceMemory uniformBufferMemory;
+        UniformRing uniformRing;
         UniformBufferObject uniformObject;
+        uint32_t uniformOffset;
 
         VkImage normalTexture;
         VkImageView normalTextureView;
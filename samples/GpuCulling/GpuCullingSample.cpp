@@ -0,0 +1,535 @@
+#include "GpuCulling/GpuCullingSample.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace vk
+{
+    bool GpuCullingSample::Initialize(WindowParameters& windowParams,
+        std::vector<const char*> validationLayer,
+        std::vector<const char*> instanceExtensions,
+        std::vector<const char*> deviceExtensions)
+    {
+        //the depth of every frame is reduced into the pyramid, so it has to be sampled and cannot be transient
+        if (!InitVulkan(windowParams, validationLayer, instanceExtensions, deviceExtensions, nullptr,
+            true, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT))
+        {
+            return false;
+        }
+
+        //upload mesh data
+        if (!MeshLoader::LoadMesh("models/knot.obj", true, false, false, true, model))
+        {
+            return false;
+        }
+
+        VkDeviceSize vertexBufferSize = sizeof(model.data[0]) * model.data.size();
+        CreateBuffer(device, vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            vertexBuffer);
+        AllocateAndBindMemoryObjectToBuffer(device, physicalDevice, vertexBuffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            vertexBufferMemory);
+
+        UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound(device, physicalDevice, vertexBufferSize,
+            &model.data[0], vertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+            graphicsQueue.handle, setupCommandBuffer, {});
+
+        //culling pipelines only live inside the culling object, so their modules are not kept
+        VkShaderModule cullShaderModule = VK_NULL_HANDLE;
+        VkShaderModule pyramidShaderModule = VK_NULL_HANDLE;
+        bool cullingShadersLoaded =
+            LoadShaderModuleFromSource(device, "shaders/Culling/cull.comp", VK_SHADER_STAGE_COMPUTE_BIT, {},
+                "shaders/cache", "shaders/Culling/cullSPIRV.comp.txt", cullShaderModule) &&
+            LoadShaderModuleFromSource(device, "shaders/Culling/depthPyramid.comp", VK_SHADER_STAGE_COMPUTE_BIT, {},
+                "shaders/cache", "shaders/Culling/depthPyramidSPIRV.comp.txt", pyramidShaderModule);
+
+        uint32_t maxInstancesCount = gridSize * gridSize * static_cast<uint32_t>(model.meshes.size());
+        bool cullingCreated = cullingShadersLoaded && CreateGpuCulling(device, physicalDevice, cullShaderModule,
+            pyramidShaderModule, maxInstancesCount, framesCount, false, culling);
+
+        if (cullShaderModule != VK_NULL_HANDLE)
+        {
+            DestroyShaderModule(device, cullShaderModule);
+        }
+        if (pyramidShaderModule != VK_NULL_HANDLE)
+        {
+            DestroyShaderModule(device, pyramidShaderModule);
+        }
+        if (!cullingCreated || !CreateCullingInstances())
+        {
+            return false;
+        }
+
+        //the pyramid is built from the depth attachment of whichever frame in flight is recorded
+        std::vector<VkImageView> depthViews;
+        for (auto& frame : frameResources)
+        {
+            depthViews.push_back(frame.depthAttachment);
+        }
+        ResizeGpuCulling(device, physicalDevice, culling, swapchain.size, depthViews);
+
+        if (!CreateUniformRing(device, physicalDevice, sizeof(UniformBufferObject), framesCount, uniformRing))
+        {
+            return false;
+        }
+
+        glm::mat4 projectionMatrix = glm::perspective(glm::radians(60.0f),
+            static_cast<float>(swapchain.size.width) / static_cast<float>(swapchain.size.height),
+            0.01f, 100.0f);
+        projectionMatrix[1][1] *= -1;
+
+        uniformObject = {
+            glm::mat4(1.0f),
+            glm::mat4(1.0f),
+            projectionMatrix
+        };
+
+        //descriptor set with uniform buffer and the instances the culling pass reads
+        std::vector<VkDescriptorSetLayoutBinding> descriptorLayoutBindings =
+        {
+            {
+                0,
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                1,
+                VK_SHADER_STAGE_VERTEX_BIT,
+                nullptr
+            },
+            {
+                1,
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                1,
+                VK_SHADER_STAGE_VERTEX_BIT,
+                nullptr
+            }
+        };
+        CreateDescriptorSetLayout(device, descriptorLayoutBindings, descriptorSetLayout);
+
+        std::vector<VkDescriptorPoolSize> descriptorPoolSizes =
+        {
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 },
+        };
+        CreateDescriptorPool(device, false, 1, descriptorPoolSizes, descriptorPool);
+        AllocateDescriptorSets(device, descriptorPool, { descriptorSetLayout }, descriptorSets);
+
+        std::vector<BufferDescriptorInfo> bufferDescriptorUpdates =
+        {
+            { descriptorSets[0], 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                { { uniformRing.storage.buffer, 0, sizeof(UniformBufferObject) } } },
+            { descriptorSets[0], 1, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                { { culling.instances.buffer, 0, sizeof(CullingInstance) * culling.maxInstancesCount } } },
+        };
+        UpdateDescriptorSets(device, {}, bufferDescriptorUpdates, {}, {});
+
+        //RenderPass, depth is stored for the pyramid reduction recorded after it
+        std::vector<VkAttachmentDescription> attachmentDescriptions =
+        {
+            {
+                0,
+                swapchain.format,
+                VK_SAMPLE_COUNT_1_BIT,
+                VK_ATTACHMENT_LOAD_OP_CLEAR,
+                VK_ATTACHMENT_STORE_OP_STORE,
+                VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            },
+            {
+                0,
+                depthFormat,
+                VK_SAMPLE_COUNT_1_BIT,
+                VK_ATTACHMENT_LOAD_OP_CLEAR,
+                VK_ATTACHMENT_STORE_OP_STORE,
+                VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+            },
+        };
+
+        VkAttachmentReference depthAttachment =
+        {
+            1,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+        };
+        VkAttachmentReference colorAttachment =
+        {
+            0,
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+        };
+
+        std::vector<SubpassParams> subpassParams =
+        {
+            {
+                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                {},
+                {colorAttachment},
+                {},
+                &depthAttachment,
+                {},
+            },
+        };
+
+        std::vector<VkSubpassDependency> subpassDependencies =
+        {
+            {
+                VK_SUBPASS_EXTERNAL,
+                0,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+                VK_ACCESS_MEMORY_READ_BIT,
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                VK_DEPENDENCY_BY_REGION_BIT
+            },
+            {
+                0,
+                VK_SUBPASS_EXTERNAL,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                VK_ACCESS_MEMORY_READ_BIT,
+                VK_DEPENDENCY_BY_REGION_BIT
+            },
+        };
+
+        CreateRenderPass(device, attachmentDescriptions, subpassParams, subpassDependencies, renderPass);
+
+        //graphics pipeline
+        std::vector<VkPushConstantRange> range =
+        {
+            {
+                VK_SHADER_STAGE_FRAGMENT_BIT,
+                0,
+                sizeof(float) * 4
+            }
+        };
+
+        std::vector<VkDescriptorSetLayout> descriptorLayouts = { descriptorSetLayout };
+        CreatePipelineLayout(device, descriptorLayouts, range, pipelineLayout);
+
+        VkShaderModule vertexShaderModule = VK_NULL_HANDLE;
+        VkShaderModule fragmentShaderModule = VK_NULL_HANDLE;
+        bool pipelineCreated =
+            LoadShaderModuleFromSource(device, "shaders/Culling/instanced.vert", VK_SHADER_STAGE_VERTEX_BIT, {},
+                "shaders/cache", "shaders/Culling/instancedSPIRV.vert.txt", vertexShaderModule) &&
+            LoadShaderModuleFromSource(device, "shaders/Culling/instanced.frag", VK_SHADER_STAGE_FRAGMENT_BIT, {},
+                "shaders/cache", "shaders/Culling/instancedSPIRV.frag.txt", fragmentShaderModule) &&
+            CreatePipeline(vertexShaderModule, fragmentShaderModule);
+
+        if (vertexShaderModule != VK_NULL_HANDLE)
+        {
+            DestroyShaderModule(device, vertexShaderModule);
+        }
+        if (fragmentShaderModule != VK_NULL_HANDLE)
+        {
+            DestroyShaderModule(device, fragmentShaderModule);
+        }
+
+        return pipelineCreated;
+    }
+
+    bool GpuCullingSample::CreateCullingInstances()
+    {
+        //one sphere around the whole mesh bounds every part of it
+        glm::vec3 minimum = glm::vec3(model.data[0], model.data[1], model.data[2]);
+        glm::vec3 maximum = minimum;
+        for (size_t i = 0; i + 5 < model.data.size(); i += 6)
+        {
+            glm::vec3 position = glm::vec3(model.data[i], model.data[i + 1], model.data[i + 2]);
+            minimum = glm::min(minimum, position);
+            maximum = glm::max(maximum, position);
+        }
+
+        glm::vec3 center = (minimum + maximum) * 0.5f;
+        float radius = 0.0f;
+        for (size_t i = 0; i + 5 < model.data.size(); i += 6)
+        {
+            float distance = glm::length(glm::vec3(model.data[i], model.data[i + 1], model.data[i + 2]) - center);
+            radius = distance > radius ? distance : radius;
+        }
+
+        //a flat grid of knots, the near rows hide the far ones from a low camera
+        std::vector<CullingInstance> instances;
+        float spacing = 2.5f * radius;
+        float gridOffset = 0.5f * spacing * static_cast<float>(gridSize - 1);
+        for (uint32_t x = 0; x < gridSize; x++)
+        {
+            for (uint32_t z = 0; z < gridSize; z++)
+            {
+                glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f),
+                    glm::vec3(spacing * x - gridOffset, 0.0f, spacing * z - gridOffset));
+                const float* matrix = &modelMatrix[0][0];
+
+                for (auto& part : model.meshes)
+                {
+                    CullingInstance instance = {};
+                    std::copy(matrix, matrix + 16, instance.model);
+                    instance.boundingSphere[0] = center.x;
+                    instance.boundingSphere[1] = center.y;
+                    instance.boundingSphere[2] = center.z;
+                    instance.boundingSphere[3] = radius;
+                    instance.count = part.vertexCount;
+                    instance.first = part.vertexOffset;
+                    instances.push_back(instance);
+                }
+            }
+        }
+
+        SetGpuCullingInstances(device, culling, instances);
+        return culling.instancesCount > 0;
+    }
+
+    bool GpuCullingSample::CreatePipeline(VkShaderModule vertexModule,
+        VkShaderModule fragmentModule)
+    {
+        std::vector<ShaderStageParams> shaderStageParams =
+        {
+            {
+                VK_SHADER_STAGE_VERTEX_BIT,
+                vertexModule,
+                "main",
+                nullptr
+            },
+            {
+                VK_SHADER_STAGE_FRAGMENT_BIT,
+                fragmentModule,
+                "main",
+                nullptr
+            },
+        };
+
+        std::vector<VkPipelineShaderStageCreateInfo> shaderStageInfos;
+        SpecifyPipelineShaderStages(shaderStageParams, shaderStageInfos);
+
+        std::vector<VkVertexInputBindingDescription> vertexInputDescriptions =
+        {
+            {
+                0,
+                6 * sizeof(float),
+                VK_VERTEX_INPUT_RATE_VERTEX
+            },
+        };
+
+        std::vector<VkVertexInputAttributeDescription> vertexAttributeDescription =
+        {
+            {
+                0,
+                0,
+                VK_FORMAT_R32G32B32_SFLOAT,
+                0,
+            },
+            {
+                1,
+                0,
+                VK_FORMAT_R32G32B32_SFLOAT,
+                3 * sizeof(float),
+            },
+        };
+
+        VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo;
+        SpecifyPipelineVertexInputState(vertexInputDescriptions, vertexAttributeDescription, vertexInputStateCreateInfo);
+
+        VkPipelineInputAssemblyStateCreateInfo assemblyStateCreateInfo;
+        SpecifyPipelineInputAssemblyStage(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, false, assemblyStateCreateInfo);
+
+        VkViewport viewport = {
+            0.0f,
+            0.0f,
+            static_cast<float>(swapchain.size.width),
+            static_cast<float>(swapchain.size.height),
+            0.0f,
+            1.0f,
+        };
+
+        VkOffset2D offset = { 0, 0 };
+        VkRect2D rect = { offset, swapchain.size };
+
+        ViewportInfo viewportInfo =
+        {
+            {viewport}, {rect}
+        };
+
+        VkPipelineViewportStateCreateInfo viewportStateCreateInfo;
+        SpecifyPipelineViewportAndScissorTestState(viewportInfo, viewportStateCreateInfo);
+
+        VkPipelineRasterizationStateCreateInfo resterizationStateCreateInfo;
+        SpecifyPipelineRasterizationState(false, false, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, VK_FRONT_FACE_COUNTER_CLOCKWISE,
+            false, 0.0f, 0.0f, 0.0f, 1.0f, resterizationStateCreateInfo);
+
+        VkPipelineMultisampleStateCreateInfo multisampleStateCreateInfo;
+        SpecifyPipelineMultisamlpeState(VK_SAMPLE_COUNT_1_BIT, false, 0.0f, 0, false, false, multisampleStateCreateInfo);
+
+        VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfoInfo;
+        SpecifPipelineDepthAndStencilState(true, true, VK_COMPARE_OP_LESS_OR_EQUAL,
+            false, 0.0f, 1.0f, false, {}, {}, depthStencilStateCreateInfoInfo);
+
+        std::vector<VkPipelineColorBlendAttachmentState> attachmentBlendStates =
+        {
+            {
+                false,
+                VK_BLEND_FACTOR_ONE,
+                VK_BLEND_FACTOR_ONE,
+                VK_BLEND_OP_ADD,
+                VK_BLEND_FACTOR_ONE,
+                VK_BLEND_FACTOR_ONE,
+                VK_BLEND_OP_ADD,
+                VK_COLOR_COMPONENT_R_BIT |
+                VK_COLOR_COMPONENT_G_BIT |
+                VK_COLOR_COMPONENT_B_BIT |
+                VK_COLOR_COMPONENT_A_BIT
+            }
+        };
+
+        VkPipelineColorBlendStateCreateInfo blendStateCreateInfo;
+        SpecifyPipelineBlendState(false, VK_LOGIC_OP_COPY, attachmentBlendStates, {1.0f, 1.0f, 1.0f, 1.0f}, blendStateCreateInfo);
+
+        std::vector<VkDynamicState> dynamicStates =
+        {
+            VK_DYNAMIC_STATE_VIEWPORT,
+            VK_DYNAMIC_STATE_SCISSOR,
+        };
+
+        VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo;
+        SpecifyPipelineDynamicStates(dynamicStates, dynamicStateCreateInfo);
+
+        VkGraphicsPipelineCreateInfo pipelineCreateInfo;
+        SpecifyGraphicsPipelineParameters(0, shaderStageInfos, vertexInputStateCreateInfo, assemblyStateCreateInfo,
+            nullptr, &viewportStateCreateInfo, resterizationStateCreateInfo, &multisampleStateCreateInfo, &depthStencilStateCreateInfoInfo,
+            &blendStateCreateInfo, &dynamicStateCreateInfo, pipelineLayout, renderPass, 0, VK_NULL_HANDLE, -1, pipelineCreateInfo);
+
+        std::vector<VkPipeline> pipelines;
+        CreateGraphicsPipelines(device, {pipelineCreateInfo}, VK_NULL_HANDLE, pipelines);
+        pipeline = pipelines[0];
+        return pipeline != VK_NULL_HANDLE;
+    }
+
+    bool GpuCullingSample::Draw()
+    {
+        //the camera circles the grid, so the pyramid of the previous frame never matches the current view
+        cameraAngle += 0.005f;
+        float cameraDistance = 0.6f * static_cast<float>(gridSize);
+        uniformObject.ViewMatrix = glm::lookAt(
+            glm::vec3(cameraDistance * std::cos(cameraAngle), 1.5f, cameraDistance * std::sin(cameraAngle)),
+            glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 viewProjection = uniformObject.ProjectionMatrix * uniformObject.ViewMatrix * uniformObject.ModelMatrix;
+
+        auto recordCommandBuffer = [&](VkCommandBuffer commandBuffer, uint32_t imageIndex, VkFramebuffer framebuffer)
+        {
+            BeginCommandBufferRecordingOperation(commandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr);
+
+            BeginUniformRingFrame(uniformRing, frameScheduler.frameIndex);
+            uint32_t uniformOffset;
+            if (!PushUniformData(uniformRing, &uniformObject, sizeof(uniformObject), uniformOffset))
+            {
+                return false;
+            }
+            FlushUniformRingFrame(device, uniformRing);
+
+            //draw commands are written before the render pass that consumes them
+            if (!RecordGpuCulling(device, commandBuffer, culling, frameScheduler.frameIndex, &viewProjection[0][0]))
+            {
+                return false;
+            }
+
+            if (presentQueue.familyIndex != graphicsQueue.familyIndex)
+            {
+                ImageTransition transitionBeforeDrawing =
+                {
+                    swapchain.images[imageIndex],
+                    VK_ACCESS_MEMORY_READ_BIT,
+                    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_UNDEFINED,
+                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                    presentQueue.familyIndex,
+                    graphicsQueue.familyIndex,
+                    VK_IMAGE_ASPECT_COLOR_BIT,
+                };
+
+                SetImageMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, { transitionBeforeDrawing });
+            }
+
+            BeginRenderPass(commandBuffer, renderPass, framebuffer, { {0,0}, swapchain.size },
+                { {0.1f, 0.2f, 0.3f, 1.0f}, {1.0f, 0} }, VK_SUBPASS_CONTENTS_INLINE);
+
+            VkViewport viewport = {
+                0.0f,
+                0.0f,
+                static_cast<float>(swapchain.size.width),
+                static_cast<float>(swapchain.size.height),
+                0.0f,
+                1.0f,
+            };
+
+            SetViewportStateDynamically(commandBuffer, 0, { viewport });
+
+            VkOffset2D scissor = { 0, 0 };
+            VkRect2D rect = { scissor, swapchain.size };
+            SetScissorsStateDynamically(commandBuffer, 0, { rect });
+
+            BindVertexBuffers(commandBuffer, 0, { {vertexBuffer, 0} });
+            BindDescitorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, descriptorSets,
+                { uniformOffset });
+            BindPipelineObject(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            std::array<float, 4> lightPosition = { 5.0f, 5.0f, 0.0f, 0.0f };
+            ProvidePushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(float) * 4,
+                &lightPosition[0]);
+
+            //every instance is one indirect draw, culled ones are skipped or draw no instances
+            DrawGpuCulledGeometry(commandBuffer, culling);
+
+            EndRenderPass(commandBuffer);
+
+            //the depth this frame was drawn with becomes the occlusion reference of the next one
+            RecordDepthPyramid(commandBuffer, culling, depthImages[frameScheduler.frameIndex], frameScheduler.frameIndex,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+
+            if (presentQueue.familyIndex != graphicsQueue.familyIndex)
+            {
+                ImageTransition transitionBeforeDrawing =
+                {
+                    swapchain.images[imageIndex],
+                    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                    VK_ACCESS_MEMORY_READ_BIT,
+                    VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                    VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                    graphicsQueue.familyIndex,
+                    presentQueue.familyIndex,
+                    VK_IMAGE_ASPECT_COLOR_BIT,
+                };
+
+                SetImageMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, { transitionBeforeDrawing });
+            }
+
+            EndCommandBufferRecordingOperation(commandBuffer);
+            return true;
+        };
+
+        RenderScheduledFrame(device, frameScheduler, presentQueue.handle, swapchain.handle, swapchain.size,
+            swapchain.imageViews, renderPass, {}, recordCommandBuffer, frameResources);
+
+        return true;
+    }
+
+    bool GpuCullingSample::Resize()
+    {
+        return true;
+    }
+
+    void GpuCullingSample::Destroy()
+    {
+        WaitForAllSumbittedCommandsToBeFinished(device);
+        DestroyGpuCulling(device, culling);
+        DestroyUniformRing(device, uniformRing);
+        DestroyPipeline(device, pipeline);
+        DestroyPipelineLayout(device, pipelineLayout);
+        DestroyRenderPass(device, renderPass);
+        DestroyDescriptorPool(device, descriptorPool);
+        DestroyDescriptorSetLayout(device, descriptorSetLayout);
+        DestroyBuffer(device, vertexBuffer);
+        FreeDeviceMemoryObject(device, vertexBufferMemory);
+        VulkanSample::Destroy();
+    }
+}
\ No newline at end of file
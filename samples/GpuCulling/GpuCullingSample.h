@@ -0,0 +1,43 @@
+#pragma once
+
+#include "VulkanSampleBase.h"
+
+namespace vk
+{
+    class GpuCullingSample : public VulkanSample
+    {
+    public:
+        virtual bool Initialize(WindowParameters& windowParams,
+            std::vector<const char*> validationLayer,
+            std::vector<const char*> instanceExtensions,
+            std::vector<const char*> deviceExtensions) override;
+        virtual bool Draw()  override;
+        virtual bool Resize()  override;
+        virtual void Destroy()  override;
+
+    private:
+        bool CreateCullingInstances();
+        bool CreatePipeline(VkShaderModule vertexModule,
+            VkShaderModule fragmentModule);
+
+    private:
+        Mesh model;
+        VkBuffer vertexBuffer;
+        VkDeviceMemory vertexBufferMemory;
+
+        GpuCulling culling;
+        uint32_t gridSize = 24;
+        float cameraAngle = 0.0f;
+
+        VkDescriptorSetLayout descriptorSetLayout;
+        VkDescriptorPool descriptorPool;
+        std::vector<VkDescriptorSet> descriptorSets;
+
+        VkRenderPass renderPass;
+        VkPipelineLayout pipelineLayout;
+        VkPipeline pipeline;
+
+        UniformRing uniformRing;
+        UniformBufferObject uniformObject;
+    };
+}
\ No newline at end of file
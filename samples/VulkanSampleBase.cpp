@@ -57,12 +57,63 @@ namespace vk
                 requstedQueues.push_back({ presentQueue.familyIndex, {1.0f} });
             }
 
-            if (!CreateLogicalDevice(gpu, deviceExtensions, validationLayer, requstedQueues,
-                deviceFeatures, true, device))
+            //extended dynamic state and bindless descriptors are opt-in, the extensions are only added when the gpu needs them
+            std::vector<const char*> gpuExtensions = deviceExtensions;
+            void* featuresChain = nullptr;
+            dynamicStateSupport = {};
+            if (useExtendedDynamicState && CheckExtendedDynamicStateSupport(gpu, dynamicStateSupport))
+            {
+                EnableExtendedDynamicState(dynamicStateSupport, gpuExtensions, featuresChain);
+            }
+
+            descriptorIndexingSupport = {};
+            if (useBindlessDescriptors && CheckDescriptorIndexingSupport(gpu, descriptorIndexingSupport))
+            {
+                EnableDescriptorIndexing(descriptorIndexingSupport, gpuExtensions, featuresChain);
+            }
+
+            bool pushDescriptors = usePushDescriptors && CheckPushDescriptorSupport(gpu);
+            if (pushDescriptors)
+            {
+                gpuExtensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+            }
+
+            //frame pacing prefers one timeline per queue and falls back to per-frame fences without it
+            timelineSupport = {};
+            if (CheckTimelineSemaphoreSupport(gpu, timelineSupport))
+            {
+                EnableTimelineSemaphores(timelineSupport, gpuExtensions, featuresChain);
+            }
+
+            //the budget extension only adds a query, so it is enabled whenever it is available
+            bool memoryBudget = GetSupportedInstanceVersion() >= VK_API_VERSION_1_1 && CheckMemoryBudgetSupport(gpu);
+            if (memoryBudget)
+            {
+                gpuExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            }
+
+            //multi draw indirect is a core feature, so it is merged into the features the sample asked for
+            VkPhysicalDeviceFeatures enabledFeatures = {};
+            if (deviceFeatures != nullptr)
+            {
+                enabledFeatures = *deviceFeatures;
+            }
+            //without it indirect draws still work, one record per call
+            CheckIndirectDrawSupport(gpu, indirectDrawSupport);
+            EnableIndirectDraw(indirectDrawSupport, gpuExtensions, enabledFeatures);
+
+            if (!CreateLogicalDevice(gpu, gpuExtensions, validationLayer, requstedQueues,
+                &enabledFeatures, featuresChain, true, device))
             {
                 continue;
             }
 
+            LoadExtendedDynamicStateFunctions(device, dynamicStateSupport);
+            LoadPushDescriptorFunctions(gpu, device, pushDescriptors);
+            LoadTimelineSemaphoreFunctions(device, timelineSupport);
+            LoadIndirectDrawFunctions(device, indirectDrawSupport);
+            InitializeMemoryTracker(gpu, memoryBudget);
+
             physicalDevice = gpu;
             GetDeviceQueue(device, graphicsQueue.familyIndex, 0, graphicsQueue.handle);
             GetDeviceQueue(device, computeQueue.familyIndex, 0, computeQueue.handle);
@@ -76,34 +127,59 @@ namespace vk
             return false;
         }
 
-        //creating command pool
+        CreateFrameScheduler(device, graphicsQueue.handle, graphicsQueue.familyIndex,
+            computeQueue.handle, computeQueue.familyIndex, framesCount, frameScheduler);
+
+        //the shared pool only serves one-off setup work, frames record from their own pools
         CreateCommandPool(device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, graphicsQueue.familyIndex, commandPool);
+        std::vector<VkCommandBuffer> setupCommandBuffers;
+        AllocateCommandBuffers(device, commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1, setupCommandBuffers);
+        setupCommandBuffer = setupCommandBuffers[0];
+
+        //frames get one command pool per thread of the job system, so any job can record without locking
+        CreateJobSystem(0, jobSystem);
+        recordingThreadsCount = GetJobThreadsCount(jobSystem);
 
         //preparing frameresources
+        std::vector<DescriptorPoolRatio> frameDescriptorRatios =
+        {
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.0f },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 0.5f },
+        };
+
         for (uint32_t i = 0; i < framesCount; i++)
         {
-            std::vector<VkCommandBuffer> commandBuffer;
             VkSemaphore imageAcquiredSemaphore;
             VkSemaphore readyToPresentSemaphore;
-            VkFence drawingFinishedFence;
-            VkImageView depthAttachment;
+            VkImageView depthAttachment = VK_NULL_HANDLE;
 
-            AllocateCommandBuffers(device, commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-                1, commandBuffer);
+            //frame completion is tracked by the frame scheduler, with a timeline or its own fences, so no per frame fence is made
             CreateVkSemaphore(device, imageAcquiredSemaphore);
             CreateVkSemaphore(device, readyToPresentSemaphore);
-            CreateVkFence(device, true, drawingFinishedFence);
 
             frameResources.push_back(
                 {
-                    commandBuffer[0],
+                    VK_NULL_HANDLE,
                     std::move(imageAcquiredSemaphore),
                     std::move(readyToPresentSemaphore),
-                    std::move(drawingFinishedFence),
                     std::move(depthAttachment),
                     {}
                 }
             );
+
+            CreateDescriptorAllocator(device, 64, frameDescriptorRatios, frameResources.back().descriptorAllocator);
+            CreateFrameCommandPool(device, graphicsQueue.familyIndex, recordingThreadsCount,
+                frameResources.back().commandPool);
+        }
+
+        //static scenes replay one recording per frame in flight and swapchain image
+        commandBufferCache = {};
+        if (useCommandBufferCache)
+        {
+            CreateCommandBufferCache(device, graphicsQueue.familyIndex, framesCount, commandBufferCache);
         }
 
         swapchain.format = VK_FORMAT_R8G8B8A8_UNORM;
@@ -145,16 +221,25 @@ namespace vk
                 swapchain.imageViews[i]);
         }
 
+        //depth attachments of the previous swapchain size are no longer needed
+        DestroyDepthAttachments();
         depthImages.resize(framesCount);
         depthImageMemory.resize(framesCount);
 
+        //depth is stored with DONT_CARE, so it can live in lazily allocated memory when the gpu has it
         for (int i = 0; i < framesCount; i++)
         {
-            Create2DImageAndView(device, physicalDevice, depthFormat, swapchain.size, 1, 1,
+            Create2DTransientAttachmentAndView(device, physicalDevice, depthFormat, swapchain.size,
                 VK_SAMPLE_COUNT_1_BIT, depthImageUsage, VK_IMAGE_ASPECT_DEPTH_BIT,
                 depthImages[i], depthImageMemory[i], frameResources[i].depthAttachment);
         }
 
+        //recordings and framebuffers of the old swapchain reference views that no longer exist
+        if (commandBufferCache.pool != VK_NULL_HANDLE)
+        {
+            ResizeCommandBufferCache(device, commandBufferCache, static_cast<uint32_t>(swapchain.images.size()));
+        }
+
         isReady = true;
         return true;
     }
@@ -164,7 +249,43 @@ namespace vk
         return isReady;
     }
 
+    void VulkanSample::DestroyDepthAttachments()
+    {
+        for (size_t i = 0; i < depthImages.size(); i++)
+        {
+            if (frameResources[i].depthAttachment != VK_NULL_HANDLE)
+            {
+                DestroyImageView(device, frameResources[i].depthAttachment);
+                frameResources[i].depthAttachment = VK_NULL_HANDLE;
+            }
+            if (depthImages[i] != VK_NULL_HANDLE)
+            {
+                DestroyImage(device, depthImages[i]);
+            }
+            if (depthImageMemory[i] != VK_NULL_HANDLE)
+            {
+                FreeDeviceMemoryObject(device, depthImageMemory[i]);
+            }
+        }
+
+        depthImages.clear();
+        depthImageMemory.clear();
+    }
+
     void VulkanSample::Destroy()
     {
+        DestroyDepthAttachments();
+        for (auto& frame : frameResources)
+        {
+            DestroyDescriptorAllocator(device, frame.descriptorAllocator);
+            DestroyFrameCommandPool(device, frame.commandPool);
+            if (frame.framebuffer != VK_NULL_HANDLE)
+            {
+                DestroyFramebuffer(device, frame.framebuffer);
+            }
+        }
+        DestroyCommandBufferCache(device, commandBufferCache);
+        DestroyFrameScheduler(device, frameScheduler);
+        DestroyJobSystem(jobSystem);
     }
 }
\ No newline at end of file
@@ -11,8 +11,25 @@
 #include "Library/Source/Resources.h"
 #include "Library/Source/RenderPass.h"
 #include "Library/Source/Pipeline.h"
+#include "Library/Source/PipelineRegistry.h"
+#include "Library/Source/ShaderCompiler.h"
+#include "Library/Source/ShaderHotReload.h"
 #include "Library/Source/Drawing.h"
 #include "Library/Source/DescriptorSets.h"
+#include "Library/Source/DescriptorAllocator.h"
+#include "Library/Source/DescriptorLayoutCache.h"
+#include "Library/Source/BindlessTable.h"
+#include "Library/Source/PushDescriptors.h"
+#include "Library/Source/FrameScheduler.h"
+#include "Library/Source/CommandBufferCache.h"
+#include "Library/Source/MappedBuffer.h"
+#include "Library/Source/MemoryTracker.h"
+#include "Library/Source/UniformRing.h"
+#include "Library/Source/BarrierBatch.h"
+#include "Library/Source/RenderGraph.h"
+#include "Library/Source/DrawList.h"
+#include "Library/Source/LinearAllocator.h"
+#include "Library/Source/GpuCulling.h"
 #include "Library/Common/TextureLoader.h"
 
 #include "glm/glm.hpp"
@@ -34,6 +51,7 @@ namespace vk
         virtual bool Resize() = 0;
         virtual void Destroy() = 0;
         virtual bool IsReady() = 0;
+        virtual void MouseClick(size_t button, bool state) {}
     };
 
     class VulkanSample : public VulkanInterface
@@ -55,6 +73,9 @@ namespace vk
         virtual bool IsReady() override;
         virtual void Destroy() override;
 
+    protected:
+        void DestroyDepthAttachments();
+
     protected:
         bool isReady;
         VkDebugUtilsMessengerEXT messenger;
@@ -67,10 +88,23 @@ namespace vk
         QueueParameters computeQueue;
         SwapchainParameters swapchain;
         VkCommandPool commandPool;
+        VkCommandBuffer setupCommandBuffer;
         std::vector<VkImage> depthImages;
         std::vector<VkDeviceMemory> depthImageMemory;
         std::vector<FrameResources> frameResources;
         uint32_t framesCount = 3;
+        uint32_t recordingThreadsCount = 1;
+        JobSystem jobSystem;
+        bool useCommandBufferCache = false;
+        CommandBufferCache commandBufferCache;
         VkFormat depthFormat = VK_FORMAT_D16_UNORM;
+        bool useExtendedDynamicState = false;
+        ExtendedDynamicStateSupport dynamicStateSupport;
+        bool useBindlessDescriptors = false;
+        DescriptorIndexingSupport descriptorIndexingSupport;
+        bool usePushDescriptors = false;
+        TimelineSemaphoreSupport timelineSupport;
+        FrameScheduler frameScheduler;
+        IndirectDrawSupport indirectDrawSupport;
     };
 }
\ No newline at end of file
@@ -7,6 +7,9 @@ namespace vk
         std::vector<const char*> instanceExtensions,
         std::vector<const char*> deviceExtensions)
     {
+        //every frame is recorded again with the mesh parts split over the job threads, the vertex diffuse sample
+        //replays cached recordings instead, setting useCommandBufferCache here switches this one over as well
+        usePushDescriptors = true;
         if (!InitVulkan(windowParams, validationLayer, instanceExtensions, deviceExtensions, nullptr,
             false, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT))
         {
@@ -24,7 +27,7 @@ namespace vk
         UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound(device, physicalDevice, vertexBufferSize,
             &model.data[0], vertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-            graphicsQueue.handle, frameResources.front().commandBuffer, {});
+            graphicsQueue.handle, setupCommandBuffer, {});
 
         //load matrix data throught staging buffer into uniform buffer
         VkDeviceSize uniformBufferSize = sizeof(UniformBufferObject);
@@ -62,14 +65,9 @@ namespace vk
             VK_SHADER_STAGE_VERTEX_BIT,
             nullptr
         };
-        CreateDescriptorSetLayout(device, { descriptorSetLayoutBind }, descriptorSetLayout);
-
-        VkDescriptorPoolSize descriptorPoolSize = {
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            1
-        };
-        CreateDescriptorPool(device, false, 1, { descriptorPoolSize }, descriptorPool);
-        AllocateDescriptorSets(device, descriptorPool, { descriptorSetLayout }, descriptorSets);
+        VkDescriptorSetLayoutCreateFlags layoutFlags = GetPushDescriptorLayoutFlags({ descriptorSetLayoutBind });
+        CreateDescriptorSetLayout(device, layoutFlags, { descriptorSetLayoutBind }, descriptorSetLayout);
+        pushUniformBuffer = layoutFlags != 0;
 
         VkDescriptorBufferInfo bufferInfo =
         {
@@ -78,16 +76,30 @@ namespace vk
             VK_WHOLE_SIZE
         };
 
-        BufferDescriptorInfo bufferDescriptorUpdate =
+        uniformBufferDescriptor =
         {
-            descriptorSets[0],
+            VK_NULL_HANDLE,
             0,
             0,
             VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
             { bufferInfo }
         };
 
-        UpdateDescriptorSets(device, {}, { bufferDescriptorUpdate }, {}, {});
+        //pushed descriptors are written into every command buffer while it is recorded, without them one set
+        //is allocated and updated up front, so the job threads never allocate from the shared frame allocator
+        if (!pushUniformBuffer)
+        {
+            VkDescriptorPoolSize descriptorPoolSize = {
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                1
+            };
+            CreateDescriptorPool(device, false, 1, { descriptorPoolSize }, descriptorPool);
+            AllocateDescriptorSets(device, descriptorPool, { descriptorSetLayout }, descriptorSets);
+
+            BufferDescriptorInfo bufferDescriptorUpdate = uniformBufferDescriptor;
+            bufferDescriptorUpdate.descriptorSet = descriptorSets[0];
+            UpdateDescriptorSets(device, {}, { bufferDescriptorUpdate }, {}, {});
+        }
 
         //RenderPass
         std::vector<VkAttachmentDescription> attachmentDescriptions =
@@ -194,6 +206,11 @@ namespace vk
         VkShaderModule fragmentShaderModule;
         CreateShaderModule(device, fragmentShader, fragmentShaderModule);
 
+        float shininess = 64.0f;
+        SpecializationConstants fragmentConstants;
+        AddSpecializationConstant(0, &shininess, sizeof(shininess), fragmentConstants);
+        SpecifySpecializationInfo(fragmentConstants);
+
         std::vector<ShaderStageParams> shaderStageParams =
         {
             {
@@ -206,7 +223,7 @@ namespace vk
                 VK_SHADER_STAGE_FRAGMENT_BIT,
                 fragmentShaderModule,
                 "main",
-                nullptr
+                &fragmentConstants.info
             },
         };
 
@@ -320,7 +337,12 @@ namespace vk
     {
         auto recordCommandBuffer = [&](VkCommandBuffer commandBuffer, uint32_t imageIndex, VkFramebuffer framebuffer)
         {
-            BeginCommandBufferRecordingOperation(commandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr);
+            //cached recordings are submitted many times, so they cannot be one time submit
+            VkCommandBufferUsageFlags usage = useCommandBufferCache ? 0 : VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            BeginCommandBufferRecordingOperation(commandBuffer, usage, nullptr);
+
+            BarrierBatch barriers;
+            BeginBarrierBatch(commandBuffer, barriers);
 
             if (updateUniformBuffer)
             {
@@ -332,8 +354,10 @@ namespace vk
                     VK_QUEUE_FAMILY_IGNORED,
                     VK_QUEUE_FAMILY_IGNORED,
                 };
-                SetBufferMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
-                    VK_PIPELINE_STAGE_TRANSFER_BIT, { preTransition });
+                AddBufferBarrierToBatch(barriers, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, preTransition);
+                FlushBarrierBatch(barriers);
+
                 VkBufferCopy region = {
                     0, 0, sizeof(uniformObject)
                 };
@@ -348,8 +372,8 @@ namespace vk
                     VK_QUEUE_FAMILY_IGNORED,
                     VK_QUEUE_FAMILY_IGNORED,
                 };
-                SetBufferMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, { postTransition });
+                AddBufferBarrierToBatch(barriers, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, postTransition);
             }
 
             if (presentQueue.familyIndex != graphicsQueue.familyIndex)
@@ -366,38 +390,72 @@ namespace vk
                     VK_IMAGE_ASPECT_COLOR_BIT,
                 };
 
-                SetImageMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, { transitionBeforeDrawing });
+                AddImageBarrierToBatch(barriers, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, transitionBeforeDrawing);
             }
 
+            //the uniform buffer and swapchain image barriers share one call in front of the render pass
+            FlushBarrierBatch(barriers);
+
+            //secondaries come from per frame pools that are reset every frame, so cached recordings stay inline
+            bool recordInParallel = !useCommandBufferCache;
             BeginRenderPass(commandBuffer, renderPass, framebuffer, { {0,0}, swapchain.size },
-                { {0.1f, 0.2f, 0.3f, 1.0f}, {1.0f, 0} }, VK_SUBPASS_CONTENTS_INLINE);
-
-            VkViewport viewport = {
-                0.0f,
-                0.0f,
-                static_cast<float>(swapchain.size.width),
-                static_cast<float>(swapchain.size.height),
-                0.0f,
-                1.0f,
-            };
+                { {0.1f, 0.2f, 0.3f, 1.0f}, {1.0f, 0} },
+                recordInParallel ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
 
-            SetViewportStateDynamically(commandBuffer, 0, { viewport });
+            auto recordDraws = [&](VkCommandBuffer drawCommandBuffer, uint32_t firstDraw, uint32_t drawCount)
+            {
+                VkViewport viewport = {
+                    0.0f,
+                    0.0f,
+                    static_cast<float>(swapchain.size.width),
+                    static_cast<float>(swapchain.size.height),
+                    0.0f,
+                    1.0f,
+                };
 
-            VkOffset2D scissor = { 0, 0 };
-            VkRect2D rect = { scissor, swapchain.size };
-            SetScissorsStateDynamically(commandBuffer, 0, { rect });
+                SetViewportStateDynamically(drawCommandBuffer, 0, { viewport });
 
-            BindVertexBuffers(commandBuffer, 0, { {vertexBuffer, 0} });
-            BindDescitorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, descriptorSets, {});
-            BindPipelineObject(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-            std::array<float, 4> lightPosition = { 5.0f, 5.0f, 0.0f, 0.0f };
-            ProvidePushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(float) * 4,
-                &lightPosition[0]);
+                VkOffset2D scissor = { 0, 0 };
+                VkRect2D rect = { scissor, swapchain.size };
+                SetScissorsStateDynamically(drawCommandBuffer, 0, { rect });
+
+                BindVertexBuffers(drawCommandBuffer, 0, { {vertexBuffer, 0} });
+                if (pushUniformBuffer)
+                {
+                    PushDescriptorSet(device, drawCommandBuffer, frameResources[frameScheduler.frameIndex].descriptorAllocator,
+                        VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, descriptorSetLayout, {}, { uniformBufferDescriptor });
+                }
+                else
+                {
+                    BindDescitorSets(drawCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, descriptorSets, {});
+                }
+                BindPipelineObject(drawCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+                std::array<float, 4> lightPosition = { 5.0f, 5.0f, 0.0f, 0.0f };
+                ProvidePushConstants(drawCommandBuffer, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(float) * 4,
+                    &lightPosition[0]);
+
+                for (uint32_t i = firstDraw; i < firstDraw + drawCount; i++)
+                {
+                    DrawGeometry(drawCommandBuffer, model.meshes[i].vertexCount, 1, model.meshes[i].vertexOffset, 0);
+                }
+            };
 
-            for (size_t i = 0; i < model.meshes.size(); i++)
+            if (recordInParallel)
             {
-                DrawGeometry(commandBuffer, model.meshes[i].vertexCount, 1, model.meshes[i].vertexOffset, 0);
+                //mesh parts are split over the job threads, each one records a secondary from its own pool
+                std::vector<VkCommandBuffer> secondaryCommandBuffers;
+                RecordSecondaryCommandBuffersInParallel(device, jobSystem, frameResources[frameScheduler.frameIndex].commandPool,
+                    renderPass, 0, framebuffer, static_cast<uint32_t>(model.meshes.size()), 0, recordDraws,
+                    secondaryCommandBuffers);
+                if (!secondaryCommandBuffers.empty())
+                {
+                    ExecuteSecondaryCommandBufferInsidePrimary(commandBuffer, secondaryCommandBuffers);
+                }
+            }
+            else
+            {
+                recordDraws(commandBuffer, 0, static_cast<uint32_t>(model.meshes.size()));
             }
 
             EndRenderPass(commandBuffer);
@@ -424,10 +482,16 @@ namespace vk
             return true;
         };
 
-        std::vector<WaitSemaphoreInfo> waitInfos;
-        IncreasePerformanceThroughtIncreasingTheNumberOfSeparatelyRenderedFrames(device, graphicsQueue.handle,
-            presentQueue.handle, swapchain.handle, swapchain.size, swapchain.imageViews,
-            renderPass, waitInfos, recordCommandBuffer, frameResources);
+        if (useCommandBufferCache)
+        {
+            RenderCachedFrame(device, frameScheduler, commandBufferCache, presentQueue.handle, swapchain.handle,
+                swapchain.size, swapchain.imageViews, renderPass, {}, recordCommandBuffer, frameResources);
+        }
+        else
+        {
+            RenderScheduledFrame(device, frameScheduler, presentQueue.handle, swapchain.handle, swapchain.size,
+                swapchain.imageViews, renderPass, {}, recordCommandBuffer, frameResources);
+        }
 
         return true;
     }
@@ -440,5 +504,6 @@ namespace vk
     void PixelDiffuseSample::Destroy()
     {
         WaitForAllSumbittedCommandsToBeFinished(device);
+        VulkanSample::Destroy();
     }
 }
\ No newline at end of file
@@ -23,6 +23,8 @@ namespace vk
         VkDescriptorSetLayout descriptorSetLayout;
         VkDescriptorPool descriptorPool;
         std::vector<VkDescriptorSet> descriptorSets;
+        BufferDescriptorInfo uniformBufferDescriptor;
+        bool pushUniformBuffer;
 
         VkRenderPass renderPass;
         VkPipelineLayout pipelineLayout;
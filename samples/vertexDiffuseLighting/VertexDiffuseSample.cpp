@@ -7,6 +7,8 @@ namespace vk
         std::vector<const char*> instanceExtensions,
         std::vector<const char*> deviceExtensions)
     {
+        //the scene never changes after loading, so frames replay cached command buffers
+        useCommandBufferCache = true;
         if (!InitVulkan(windowParams, validationLayer, instanceExtensions, deviceExtensions, nullptr,
             false, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT))
         {
@@ -24,7 +26,7 @@ namespace vk
         UseStagingBufferToUpdateBufferWithDeviceLocalMemoryBound(device, physicalDevice, vertexBufferSize,
             &model.data[0], vertexBuffer, 0, 0, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-            graphicsQueue.handle, frameResources.front().commandBuffer, {});
+            graphicsQueue.handle, setupCommandBuffer, {});
 
         //load matrix data throught staging buffer into uniform buffer
         VkDeviceSize uniformBufferSize = sizeof(UniformBufferObject);
@@ -311,7 +313,12 @@ namespace vk
     {
         auto recordCommandBuffer = [&](VkCommandBuffer commandBuffer, uint32_t imageIndex, VkFramebuffer framebuffer)
         {
-            BeginCommandBufferRecordingOperation(commandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr);
+            //cached recordings are submitted many times, so they cannot be one time submit
+            VkCommandBufferUsageFlags usage = useCommandBufferCache ? 0 : VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            BeginCommandBufferRecordingOperation(commandBuffer, usage, nullptr);
+
+            BarrierBatch barriers;
+            BeginBarrierBatch(commandBuffer, barriers);
 
             if (updateUniformBuffer)
             {
@@ -323,8 +330,10 @@ namespace vk
                     VK_QUEUE_FAMILY_IGNORED,
                     VK_QUEUE_FAMILY_IGNORED,
                 };
-                SetBufferMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
-                    VK_PIPELINE_STAGE_TRANSFER_BIT, { preTransition });
+                AddBufferBarrierToBatch(barriers, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, preTransition);
+                FlushBarrierBatch(barriers);
+
                 VkBufferCopy region = {
                     0, 0, sizeof(uniformObject)
                 };
@@ -339,8 +348,8 @@ namespace vk
                     VK_QUEUE_FAMILY_IGNORED,
                     VK_QUEUE_FAMILY_IGNORED,
                 };
-                SetBufferMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, { postTransition });
+                AddBufferBarrierToBatch(barriers, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, postTransition);
             }
 
             if (presentQueue.familyIndex != graphicsQueue.familyIndex)
@@ -357,10 +366,13 @@ namespace vk
                     VK_IMAGE_ASPECT_COLOR_BIT,
                 };
 
-                SetImageMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, { transitionBeforeDrawing });
+                AddImageBarrierToBatch(barriers, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, transitionBeforeDrawing);
             }
 
+            //the uniform buffer and swapchain image barriers share one call in front of the render pass
+            FlushBarrierBatch(barriers);
+
             BeginRenderPass(commandBuffer, renderPass, framebuffer, { {0,0}, swapchain.size },
                 { {0.1f, 0.2f, 0.3f, 1.0f}, {1.0f, 0} }, VK_SUBPASS_CONTENTS_INLINE);
 
@@ -411,10 +423,16 @@ namespace vk
             return true;
         };
 
-        std::vector<WaitSemaphoreInfo> waitInfos;
-        IncreasePerformanceThroughtIncreasingTheNumberOfSeparatelyRenderedFrames(device, graphicsQueue.handle,
-            presentQueue.handle, swapchain.handle, swapchain.size, swapchain.imageViews,
-            renderPass, waitInfos, recordCommandBuffer, frameResources);
+        if (useCommandBufferCache)
+        {
+            RenderCachedFrame(device, frameScheduler, commandBufferCache, presentQueue.handle, swapchain.handle,
+                swapchain.size, swapchain.imageViews, renderPass, {}, recordCommandBuffer, frameResources);
+        }
+        else
+        {
+            RenderScheduledFrame(device, frameScheduler, presentQueue.handle, swapchain.handle, swapchain.size,
+                swapchain.imageViews, renderPass, {}, recordCommandBuffer, frameResources);
+        }
 
         return true;
     }
@@ -427,5 +445,6 @@ namespace vk
     void VertexDiffuseSample::Destroy()
     {
         WaitForAllSumbittedCommandsToBeFinished(device);
+        VulkanSample::Destroy();
     }
 }
\ No newline at end of file
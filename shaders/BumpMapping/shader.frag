@@ -10,10 +10,17 @@ layout(location = 4) in vec3 TangentFragPos;
 
 layout(set = 0, binding = 1) uniform sampler2D normalMap;
 
+layout(constant_id = 0) const float SpecularExponent = 32.0;
+layout(constant_id = 1) const bool UseNormalMap = true;
+
 void main()
 {
-	vec3 normal = texture(normalMap, TextCoords).xyz;
-	normal = normalize(normal * 2.0 - 1.0);
+	vec3 normal = vec3(0.0, 0.0, 1.0);
+	if (UseNormalMap)
+	{
+		normal = texture(normalMap, TextCoords).xyz;
+		normal = normalize(normal * 2.0 - 1.0);
+	}
 
 	vec3 color = vec3(0.4, 0.3, 0.2);
 	vec3 ambient = color * 0.1;
@@ -24,7 +31,7 @@ void main()
 	vec3 viewDir = normalize(TangentViewPos - TangentFragPos);
 	vec3 reflectDir = reflect(-lightDir, normal);
 	vec3 halfVec = normalize(lightDir + viewDir);
-	float spec = pow(max(dot(normal, halfVec), 0.0), 32.0);
+	float spec = pow(max(dot(normal, halfVec), 0.0), SpecularExponent);
 	vec3 specular = color * spec;
 
 	FragColor = vec4(ambient + diffuse + specular, 1.0);
@@ -0,0 +1,39 @@
+#version 450
+
+layout(location = 0) in vec3 inPos;
+layout(location = 1) in vec3 inNormal;
+
+struct Instance
+{
+	mat4 Model;
+	vec4 BoundingSphere;
+	uint Count;
+	uint First;
+	int VertexOffset;
+	uint Padding;
+};
+
+layout(set = 0, binding = 0) uniform UniformBuffer
+{
+	mat4 ModelMatrix;
+	mat4 ViewMatrix;
+	mat4 ProjectionMatrix;
+} ubo;
+
+layout(std430, set = 0, binding = 1) readonly buffer Instances
+{
+	Instance instances[];
+};
+
+layout(location = 0) out vec3 vertexPosition;
+layout(location = 1) out vec3 vertexNormal;
+
+void main()
+{
+	//the culling pass writes the instance index as the first instance of every draw command
+	mat4 modelViewMatrix = ubo.ViewMatrix * ubo.ModelMatrix * instances[gl_InstanceIndex].Model;
+	vertexNormal = mat3(modelViewMatrix) * inNormal;
+	vec4 viewVertexPosition = modelViewMatrix * vec4(inPos, 1.0);
+	vertexPosition = viewVertexPosition.xyz;
+	gl_Position = ubo.ProjectionMatrix * viewVertexPosition;
+}
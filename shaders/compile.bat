@@ -6,4 +6,9 @@ D:/VulkanSDK/1.3.216.0/Bin/glslc.exe PixelDiffuseLighting/shader.vert -o PixelDi
 D:/VulkanSDK/1.3.216.0/Bin/glslc.exe PixelDiffuseLighting/shader.frag -o PixelDiffuseLighting/shaderSPIRV.frag.txt
 
 D:/VulkanSDK/1.3.216.0/Bin/glslc.exe BumpMapping/shader.vert -o BumpMapping/shaderSPIRV.vert.txt
-D:/VulkanSDK/1.3.216.0/Bin/glslc.exe BumpMapping/shader.frag -o BumpMapping/shaderSPIRV.frag.txt
\ No newline at end of file
+D:/VulkanSDK/1.3.216.0/Bin/glslc.exe BumpMapping/shader.frag -o BumpMapping/shaderSPIRV.frag.txt
+
+D:/VulkanSDK/1.3.216.0/Bin/glslc.exe Culling/cull.comp -o Culling/cullSPIRV.comp.txt
+D:/VulkanSDK/1.3.216.0/Bin/glslc.exe Culling/depthPyramid.comp -o Culling/depthPyramidSPIRV.comp.txt
+D:/VulkanSDK/1.3.216.0/Bin/glslc.exe Culling/instanced.vert -o Culling/instancedSPIRV.vert.txt
+D:/VulkanSDK/1.3.216.0/Bin/glslc.exe Culling/instanced.frag -o Culling/instancedSPIRV.frag.txt
\ No newline at end of file
@@ -9,6 +9,8 @@ layout(push_constant) uniform LightParameters {
 	vec3 position;
 } Light;
 
+layout(constant_id = 0) const float Shininess = 64.0;
+
 void main()
 {
 	const vec3 norm = normalize(vertNormal);
@@ -21,8 +23,7 @@ void main()
 	const float diffuseFactor = max(0.0, dot(norm, lightDir));
 
 	const vec3 halfVector = normalize(- vertPosition + lightDir);
-	const float shineness = 64;
-	float specular = pow(dot(halfVector, norm), shineness);
+	float specular = pow(dot(halfVector, norm), Shininess);
 
 	FragColor = ambientComponent + vec4(vec3(diffuseFactor), 1.0) + vec4(vec3(specular), 1.0);
 }
\ No newline at end of file
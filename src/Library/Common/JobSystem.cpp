@@ -0,0 +1,364 @@
+#include "JobSystem.h"
+
+namespace vk
+{
+    //workers own the first deques and the thread that created the system owns the last one, other threads own none
+    static thread_local uint32_t jobThreadIndex = UINT32_MAX;
+    static const int64_t jobDequeCapacity = 4096;
+
+    static void CreateJobDeque(JobDeque& deque)
+    {
+        deque.top = 0;
+        deque.bottom = 0;
+        deque.tasks.reset(new std::atomic<JobTask*>[jobDequeCapacity]);
+        deque.mask = jobDequeCapacity - 1;
+    }
+
+    //Chase-Lev deque, the owner pushes and pops at the bottom while thieves take from the top
+    static bool PushJobTask(JobDeque& deque,
+        JobTask* task)
+    {
+        int64_t bottom = deque.bottom.load(std::memory_order_relaxed);
+        int64_t top = deque.top.load(std::memory_order_acquire);
+        if (bottom - top > deque.mask)
+        {
+            return false;
+        }
+
+        deque.tasks[bottom & deque.mask].store(task, std::memory_order_relaxed);
+        deque.bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    static JobTask* PopJobTask(JobDeque& deque)
+    {
+        int64_t bottom = deque.bottom.load(std::memory_order_relaxed) - 1;
+        deque.bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = deque.top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        JobTask* task = deque.tasks[bottom & deque.mask].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            //a thief may be taking the last task at the same time, whoever advances top gets it
+            if (!deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                task = nullptr;
+            }
+            deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    static JobTask* StealJobTask(JobDeque& deque)
+    {
+        int64_t top = deque.top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = deque.bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        JobTask* task = deque.tasks[top & deque.mask].load(std::memory_order_relaxed);
+        if (!deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return task;
+    }
+
+    static void PushTask(JobSystem& jobSystem,
+        JobTask* task)
+    {
+        //threads without a deque, or with a full one, hand their tasks over through the shared queue
+        jobSystem.queuedJobs++;
+        uint32_t threadIndex = jobThreadIndex;
+        if (threadIndex >= jobSystem.deques.size() || !PushJobTask(*jobSystem.deques[threadIndex], task))
+        {
+            std::lock_guard<std::mutex> lock(jobSystem.injectedMutex);
+            jobSystem.injected.push_back(task);
+        }
+
+        std::lock_guard<std::mutex> lock(jobSystem.wakeMutex);
+        jobSystem.wakeCondition.notify_all();
+    }
+
+    static JobTask* FindTask(JobSystem& jobSystem,
+        uint32_t threadIndex)
+    {
+        JobTask* task = PopJobTask(*jobSystem.deques[threadIndex]);
+
+        if (task == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(jobSystem.injectedMutex);
+            if (!jobSystem.injected.empty())
+            {
+                task = jobSystem.injected.front();
+                jobSystem.injected.pop_front();
+            }
+        }
+
+        uint32_t dequesCount = static_cast<uint32_t>(jobSystem.deques.size());
+        for (uint32_t i = 1; i < dequesCount && task == nullptr; i++)
+        {
+            task = StealJobTask(*jobSystem.deques[(threadIndex + i) % dequesCount]);
+        }
+
+        if (task != nullptr)
+        {
+            jobSystem.queuedJobs--;
+        }
+        return task;
+    }
+
+    static void RunTask(JobSystem& jobSystem,
+        uint32_t threadIndex,
+        JobTask* task)
+    {
+        task->job(threadIndex);
+        JobCounter* counter = task->counter;
+        delete task;
+
+        bool wake = false;
+        if (counter != nullptr)
+        {
+            //the counter is decremented under its lock, so jobs waiting on it are released exactly once
+            std::vector<JobTask*> continuations;
+            {
+                std::lock_guard<std::mutex> lock(counter->mutex);
+                if (counter->value.fetch_sub(1) == 1)
+                {
+                    continuations.swap(counter->continuations);
+                    wake = true;
+                }
+            }
+
+            for (auto& continuation : continuations)
+            {
+                PushTask(jobSystem, continuation);
+            }
+        }
+
+        if (jobSystem.pendingJobs.fetch_sub(1) == 1)
+        {
+            wake = true;
+        }
+
+        if (wake)
+        {
+            std::lock_guard<std::mutex> lock(jobSystem.wakeMutex);
+            jobSystem.wakeCondition.notify_all();
+        }
+    }
+
+    static void WorkerLoop(JobSystem& jobSystem,
+        uint32_t threadIndex)
+    {
+        jobThreadIndex = threadIndex;
+
+        while (true)
+        {
+            JobTask* task = FindTask(jobSystem, threadIndex);
+            if (task != nullptr)
+            {
+                RunTask(jobSystem, threadIndex, task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(jobSystem.wakeMutex);
+            jobSystem.wakeCondition.wait(lock, [&]()
+            {
+                return !jobSystem.running || jobSystem.queuedJobs > 0;
+            });
+
+            if (!jobSystem.running)
+            {
+                return;
+            }
+        }
+    }
+
+    void CreateJobSystem(uint32_t workersCount,
+        JobSystem& jobSystem)
+    {
+        //one core is left to the thread that submits the jobs and helps while waiting
+        if (workersCount == 0)
+        {
+            uint32_t cores = std::thread::hardware_concurrency();
+            workersCount = cores > 1 ? cores - 1 : 1;
+        }
+
+        jobSystem.pendingJobs = 0;
+        jobSystem.queuedJobs = 0;
+        jobSystem.running = true;
+
+        jobSystem.deques.clear();
+        for (uint32_t i = 0; i <= workersCount; i++)
+        {
+            jobSystem.deques.push_back(std::make_unique<JobDeque>());
+            CreateJobDeque(*jobSystem.deques.back());
+        }
+        jobThreadIndex = workersCount;
+
+        jobSystem.workers.clear();
+        for (uint32_t i = 0; i < workersCount; i++)
+        {
+            jobSystem.workers.emplace_back(WorkerLoop, std::ref(jobSystem), i);
+        }
+    }
+
+    uint32_t GetJobThreadsCount(const JobSystem& jobSystem)
+    {
+        return static_cast<uint32_t>(jobSystem.deques.size());
+    }
+
+    void SubmitJob(JobSystem& jobSystem,
+        Job job,
+        JobCounter* counter)
+    {
+        if (counter != nullptr)
+        {
+            counter->value++;
+        }
+        jobSystem.pendingJobs++;
+
+        PushTask(jobSystem, new JobTask{ std::move(job), counter });
+    }
+
+    void SubmitJobAfter(JobSystem& jobSystem,
+        JobCounter& dependency,
+        Job job,
+        JobCounter* counter)
+    {
+        //the job counts as pending right away, so waiting on its counter also covers the dependency
+        if (counter != nullptr)
+        {
+            counter->value++;
+        }
+        jobSystem.pendingJobs++;
+
+        JobTask* task = new JobTask{ std::move(job), counter };
+        {
+            std::lock_guard<std::mutex> lock(dependency.mutex);
+            if (dependency.value > 0)
+            {
+                dependency.continuations.push_back(task);
+                return;
+            }
+        }
+
+        PushTask(jobSystem, task);
+    }
+
+    void WaitForJobCounter(JobSystem& jobSystem,
+        JobCounter& counter)
+    {
+        //threads owning a deque run jobs while they wait, which also makes waiting from inside a job safe
+        uint32_t threadIndex = jobThreadIndex;
+        bool helps = threadIndex < jobSystem.deques.size();
+
+        while (counter.value > 0)
+        {
+            if (helps)
+            {
+                JobTask* task = FindTask(jobSystem, threadIndex);
+                if (task != nullptr)
+                {
+                    RunTask(jobSystem, threadIndex, task);
+                    continue;
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(jobSystem.wakeMutex);
+            jobSystem.wakeCondition.wait(lock, [&]()
+            {
+                return counter.value == 0 || (helps && jobSystem.queuedJobs > 0);
+            });
+        }
+
+        //the thread that finished the last job may still hold the lock, the counter must outlive it
+        std::lock_guard<std::mutex> lock(counter.mutex);
+    }
+
+    void WaitForJobs(JobSystem& jobSystem)
+    {
+        //jobs must not wait for all jobs, the job doing so would count as pending forever
+        uint32_t threadIndex = jobThreadIndex;
+        bool helps = threadIndex < jobSystem.deques.size();
+
+        while (jobSystem.pendingJobs > 0)
+        {
+            if (helps)
+            {
+                JobTask* task = FindTask(jobSystem, threadIndex);
+                if (task != nullptr)
+                {
+                    RunTask(jobSystem, threadIndex, task);
+                    continue;
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(jobSystem.wakeMutex);
+            jobSystem.wakeCondition.wait(lock, [&]()
+            {
+                return jobSystem.pendingJobs == 0 || (helps && jobSystem.queuedJobs > 0);
+            });
+        }
+    }
+
+    void ParallelFor(JobSystem& jobSystem,
+        uint32_t count,
+        uint32_t grainSize,
+        std::function<void(uint32_t, uint32_t, uint32_t)> body)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        //a few ranges per thread leave room for stealing when the ranges take uneven time
+        if (grainSize == 0)
+        {
+            uint32_t ranges = GetJobThreadsCount(jobSystem) * 4;
+            grainSize = (count + ranges - 1) / ranges;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = 0; begin < count; begin += grainSize)
+        {
+            uint32_t end = count - begin < grainSize ? count : begin + grainSize;
+            SubmitJob(jobSystem, [&body, begin, end](uint32_t threadIndex)
+            {
+                body(begin, end, threadIndex);
+            }, &counter);
+        }
+
+        WaitForJobCounter(jobSystem, counter);
+    }
+
+    void DestroyJobSystem(JobSystem& jobSystem)
+    {
+        WaitForJobs(jobSystem);
+
+        {
+            std::lock_guard<std::mutex> lock(jobSystem.wakeMutex);
+            jobSystem.running = false;
+            jobSystem.wakeCondition.notify_all();
+        }
+
+        for (auto& worker : jobSystem.workers)
+        {
+            worker.join();
+        }
+        jobSystem.workers.clear();
+        jobSystem.deques.clear();
+        jobThreadIndex = UINT32_MAX;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+namespace vk
+{
+    //jobs receive the index of the thread running them, so they can use per-thread resources without locking
+    using Job = std::function<void(uint32_t)>;
+
+    struct JobCounter;
+
+    struct JobTask
+    {
+        Job job;
+        JobCounter* counter;
+    };
+
+    struct JobCounter
+    {
+        std::atomic<uint32_t> value{ 0 };
+        std::mutex mutex;
+        std::vector<JobTask*> continuations;
+    };
+
+    struct JobDeque
+    {
+        std::atomic<int64_t> top;
+        std::atomic<int64_t> bottom;
+        std::unique_ptr<std::atomic<JobTask*>[]> tasks;
+        int64_t mask;
+    };
+
+    struct JobSystem
+    {
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<JobDeque>> deques;
+        std::mutex injectedMutex;
+        std::deque<JobTask*> injected;
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+        std::atomic<uint32_t> pendingJobs;
+        std::atomic<uint32_t> queuedJobs;
+        std::atomic<bool> running;
+    };
+
+    void CreateJobSystem(uint32_t workersCount,
+        JobSystem& jobSystem);
+
+    uint32_t GetJobThreadsCount(const JobSystem& jobSystem);
+
+    void SubmitJob(JobSystem& jobSystem,
+        Job job,
+        JobCounter* counter = nullptr);
+
+    void SubmitJobAfter(JobSystem& jobSystem,
+        JobCounter& dependency,
+        Job job,
+        JobCounter* counter = nullptr);
+
+    void WaitForJobCounter(JobSystem& jobSystem,
+        JobCounter& counter);
+
+    void WaitForJobs(JobSystem& jobSystem);
+
+    void ParallelFor(JobSystem& jobSystem,
+        uint32_t count,
+        uint32_t grainSize,
+        std::function<void(uint32_t, uint32_t, uint32_t)> body);
+
+    void DestroyJobSystem(JobSystem& jobSystem);
+}
@@ -1,6 +1,17 @@
 #include "Tools.h"
 #include "Library/Core/Core.h"
 
+#include <cstdio>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace vk
 {
     bool GetBinaryFileContents(std::string const& filename,
@@ -31,4 +42,119 @@ namespace vk
 
         return true;
     }
+
+    bool WriteBinaryFileContents(std::string const& filename,
+        const std::vector<unsigned char>& contents)
+    {
+        //write next to the target and rename, so readers never observe a partially written file
+        std::string temporaryFilename = filename + ".tmp";
+        std::ofstream file(temporaryFilename, std::ios::binary | std::ios::trunc);
+        if (file.fail()) {
+            ERROR_LOG("Could not create '" + temporaryFilename + "' file.");
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(contents.data()), contents.size());
+        file.close();
+        if (file.fail()) {
+            ERROR_LOG("Could not write '" + temporaryFilename + "' file.");
+            std::remove(temporaryFilename.c_str());
+            return false;
+        }
+
+        std::remove(filename.c_str());
+        if (std::rename(temporaryFilename.c_str(), filename.c_str()) != 0) {
+            ERROR_LOG("Could not rename '" + temporaryFilename + "' file.");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool MapFileContents(std::string const& filename,
+        MappedFile& mappedFile)
+    {
+        mappedFile = { nullptr, 0, nullptr, nullptr };
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        mappedFile = { static_cast<const unsigned char*>(view), static_cast<size_t>(fileSize.QuadPart), file, mapping };
+#else
+        int file = open(filename.c_str(), O_RDONLY);
+        if (file < 0) {
+            return false;
+        }
+
+        struct stat fileStat;
+        if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+            close(file);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (view == MAP_FAILED) {
+            return false;
+        }
+
+        mappedFile = { static_cast<const unsigned char*>(view), static_cast<size_t>(fileStat.st_size), nullptr, nullptr };
+#endif
+        return true;
+    }
+
+    void UnmapFileContents(MappedFile& mappedFile)
+    {
+        if (mappedFile.data == nullptr) {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(mappedFile.data);
+        CloseHandle(mappedFile.mappingHandle);
+        CloseHandle(mappedFile.fileHandle);
+#else
+        munmap(const_cast<unsigned char*>(mappedFile.data), mappedFile.size);
+#endif
+        mappedFile = { nullptr, 0, nullptr, nullptr };
+    }
+
+    uint64_t HashBytes(const void* data,
+        size_t size,
+        uint64_t seed)
+    {
+        //FNV-1a
+        uint64_t hash = seed;
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
 }
@@ -4,9 +4,38 @@
 #include <iostream>
 #include <cmath>
 #include <vector>
+#include <string>
+#include <cstdint>
 
 namespace vk
 {
+    struct MappedFile
+    {
+        const unsigned char* data;
+        size_t size;
+        void* fileHandle;
+        void* mappingHandle;
+    };
+
     bool GetBinaryFileContents(std::string const& filename,
         std::vector<unsigned char>& contents);
+
+    bool WriteBinaryFileContents(std::string const& filename,
+        const std::vector<unsigned char>& contents);
+
+    bool MapFileContents(std::string const& filename,
+        MappedFile& mappedFile);
+
+    void UnmapFileContents(MappedFile& mappedFile);
+
+    uint64_t HashBytes(const void* data,
+        size_t size,
+        uint64_t seed = 14695981039346656037ull);
+
+    template<typename T>
+    uint64_t HashValue(const T& value,
+        uint64_t seed)
+    {
+        return HashBytes(&value, sizeof(T), seed);
+    }
 }
\ No newline at end of file
@@ -64,6 +64,9 @@ namespace vk
                 case USER_MESSAGE_QUIT:
                     loop = false;
                     break;
+                case USER_MESSAGE_MOUSE_CLICK:
+                    sample.MouseClick(static_cast<size_t>(message.wParam), message.lParam == 1);
+                    break;
                 }
                 TranslateMessage(&message);
                 DispatchMessage(&message);
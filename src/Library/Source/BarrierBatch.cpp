@@ -0,0 +1,156 @@
+#include "BarrierBatch.h"
+
+namespace vk
+{
+    void BeginBarrierBatch(VkCommandBuffer commandBuffer,
+        BarrierBatch& batch)
+    {
+        batch.commandBuffer = commandBuffer;
+        batch.srcStages = 0;
+        batch.dstStages = 0;
+        batch.memoryBarriers.clear();
+        batch.bufferBarriers.clear();
+        batch.imageBarriers.clear();
+    }
+
+    static void MergeBarrierStages(BarrierBatch& batch,
+        VkPipelineStageFlags generatingStages,
+        VkPipelineStageFlags consumingStages)
+    {
+        //one call waits for the union of producers before the union of consumers
+        batch.srcStages |= generatingStages;
+        batch.dstStages |= consumingStages;
+    }
+
+    void AddMemoryBarrierToBatch(BarrierBatch& batch,
+        VkPipelineStageFlags generatingStages,
+        VkPipelineStageFlags consumingStages,
+        VkAccessFlags srcAccess,
+        VkAccessFlags dstAccess)
+    {
+        MergeBarrierStages(batch, generatingStages, consumingStages);
+
+        //global barriers carry no resource, so a single one holds every access mask
+        if (batch.memoryBarriers.empty())
+        {
+            batch.memoryBarriers.push_back({ VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, 0, 0 });
+        }
+        batch.memoryBarriers[0].srcAccessMask |= srcAccess;
+        batch.memoryBarriers[0].dstAccessMask |= dstAccess;
+    }
+
+    void AddBufferBarrierToBatch(BarrierBatch& batch,
+        VkPipelineStageFlags generatingStages,
+        VkPipelineStageFlags consumingStages,
+        const BufferTransition& transition)
+    {
+        for (auto& barrier : batch.bufferBarriers)
+        {
+            if (barrier.buffer != transition.buffer)
+            {
+                continue;
+            }
+
+            //a second dependency on the same buffer has to be ordered after the first one
+            if (barrier.srcQueueFamilyIndex != transition.srcQueueFamilyIndex ||
+                barrier.dstQueueFamilyIndex != transition.dstQueueFamilyIndex ||
+                (barrier.dstAccessMask & transition.srcFlags) != 0)
+            {
+                FlushBarrierBatch(batch);
+                break;
+            }
+
+            MergeBarrierStages(batch, generatingStages, consumingStages);
+            barrier.srcAccessMask |= transition.srcFlags;
+            barrier.dstAccessMask |= transition.dstFlags;
+            return;
+        }
+
+        MergeBarrierStages(batch, generatingStages, consumingStages);
+        batch.bufferBarriers.push_back(
+            {
+                VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                nullptr,
+                transition.srcFlags,
+                transition.dstFlags,
+                transition.srcQueueFamilyIndex,
+                transition.dstQueueFamilyIndex,
+                transition.buffer,
+                0,
+                VK_WHOLE_SIZE
+            });
+    }
+
+    void AddImageBarrierToBatch(BarrierBatch& batch,
+        VkPipelineStageFlags generatingStages,
+        VkPipelineStageFlags consumingStages,
+        const ImageTransition& transition)
+    {
+        for (auto& barrier : batch.imageBarriers)
+        {
+            if (barrier.image != transition.image)
+            {
+                continue;
+            }
+
+            //barriers in one call are unordered, so a chained layout transition needs its own call
+            if (barrier.oldLayout != transition.srcLayout || barrier.newLayout != transition.dstLayout ||
+                barrier.srcQueueFamilyIndex != transition.srcQueueFamilyIndex ||
+                barrier.dstQueueFamilyIndex != transition.dstQueueFamilyIndex ||
+                barrier.subresourceRange.aspectMask != transition.aspect)
+            {
+                FlushBarrierBatch(batch);
+                break;
+            }
+
+            MergeBarrierStages(batch, generatingStages, consumingStages);
+            barrier.srcAccessMask |= transition.srcAccessFlags;
+            barrier.dstAccessMask |= transition.dstAccessFlags;
+            return;
+        }
+
+        MergeBarrierStages(batch, generatingStages, consumingStages);
+        batch.imageBarriers.push_back(
+            {
+                VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                nullptr,
+                transition.srcAccessFlags,
+                transition.dstAccessFlags,
+                transition.srcLayout,
+                transition.dstLayout,
+                transition.srcQueueFamilyIndex,
+                transition.dstQueueFamilyIndex,
+                transition.image,
+                {
+                    transition.aspect,
+                    0,
+                    VK_REMAINING_MIP_LEVELS,
+                    0,
+                    VK_REMAINING_ARRAY_LAYERS
+                }
+            });
+    }
+
+    bool IsBarrierBatchEmpty(const BarrierBatch& batch)
+    {
+        return batch.memoryBarriers.empty() && batch.bufferBarriers.empty() && batch.imageBarriers.empty();
+    }
+
+    void FlushBarrierBatch(BarrierBatch& batch)
+    {
+        if (IsBarrierBatchEmpty(batch))
+        {
+            return;
+        }
+
+        VkPipelineStageFlags srcStages = batch.srcStages != 0 ? batch.srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        VkPipelineStageFlags dstStages = batch.dstStages != 0 ? batch.dstStages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+        vkCmdPipelineBarrier(batch.commandBuffer, srcStages, dstStages, 0,
+            static_cast<uint32_t>(batch.memoryBarriers.size()), batch.memoryBarriers.data(),
+            static_cast<uint32_t>(batch.bufferBarriers.size()), batch.bufferBarriers.data(),
+            static_cast<uint32_t>(batch.imageBarriers.size()), batch.imageBarriers.data());
+
+        BeginBarrierBatch(batch.commandBuffer, batch);
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "Library/Structs/Barrier.h"
+#include "Library/Structs/Buffer.h"
+#include "Library/Structs/Image.h"
+
+namespace vk
+{
+    void BeginBarrierBatch(VkCommandBuffer commandBuffer,
+        BarrierBatch& batch);
+
+    void AddMemoryBarrierToBatch(BarrierBatch& batch,
+        VkPipelineStageFlags generatingStages,
+        VkPipelineStageFlags consumingStages,
+        VkAccessFlags srcAccess,
+        VkAccessFlags dstAccess);
+
+    void AddBufferBarrierToBatch(BarrierBatch& batch,
+        VkPipelineStageFlags generatingStages,
+        VkPipelineStageFlags consumingStages,
+        const BufferTransition& transition);
+
+    void AddImageBarrierToBatch(BarrierBatch& batch,
+        VkPipelineStageFlags generatingStages,
+        VkPipelineStageFlags consumingStages,
+        const ImageTransition& transition);
+
+    bool IsBarrierBatchEmpty(const BarrierBatch& batch);
+
+    void FlushBarrierBatch(BarrierBatch& batch);
+}
@@ -0,0 +1,293 @@
+#include "BindlessTable.h"
+
+namespace vk
+{
+    static const uint32_t bindlessTextureBinding = 0;
+    static const uint32_t bindlessBufferBinding = 1;
+
+    static uint32_t MinLimit(uint32_t first,
+        uint32_t second)
+    {
+        return first < second ? first : second;
+    }
+
+    bool CheckDescriptorIndexingSupport(VkPhysicalDevice physicalDevice,
+        DescriptorIndexingSupport& support)
+    {
+        support = {};
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+        uint32_t instanceVersion = GetSupportedInstanceVersion();
+        uint32_t version = instanceVersion < properties.apiVersion ? instanceVersion : properties.apiVersion;
+        if (version < VK_API_VERSION_1_1)
+        {
+            return false;
+        }
+
+        std::vector<VkExtensionProperties> availableExtensions;
+        if (!CheckAvailableDeviceExtensions(physicalDevice, availableExtensions))
+        {
+            return false;
+        }
+
+        support.core = version >= VK_API_VERSION_1_2;
+        if (!support.core && !IsExtensionSupported(availableExtensions, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+        {
+            return false;
+        }
+
+        support.features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES };
+        VkPhysicalDeviceFeatures2 features =
+        {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            &support.features
+        };
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+        VkPhysicalDeviceDescriptorIndexingProperties indexingProperties =
+        {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES
+        };
+        VkPhysicalDeviceProperties2 properties2 =
+        {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            &indexingProperties
+        };
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+
+        //combined image samplers count as both a sampled image and a sampler, and the table is visible to every stage
+        support.maxSampledImages = MinLimit(
+            MinLimit(indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+                indexingProperties.maxDescriptorSetUpdateAfterBindSamplers),
+            MinLimit(indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers));
+        support.maxStorageBuffers = MinLimit(indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+            indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers);
+        support.maxPerStageResources = indexingProperties.maxPerStageUpdateAfterBindResources;
+
+        const VkPhysicalDeviceDescriptorIndexingFeatures& available = support.features;
+        support.supported = available.runtimeDescriptorArray &&
+            available.descriptorBindingPartiallyBound &&
+            available.descriptorBindingUpdateUnusedWhilePending &&
+            available.descriptorBindingSampledImageUpdateAfterBind &&
+            available.descriptorBindingStorageBufferUpdateAfterBind &&
+            available.shaderSampledImageArrayNonUniformIndexing;
+
+        return support.supported;
+    }
+
+    void EnableDescriptorIndexing(DescriptorIndexingSupport& support,
+        std::vector<const char*>& deviceExtensions,
+        void*& featuresChain)
+    {
+        if (!support.supported)
+        {
+            return;
+        }
+
+        if (!support.core)
+        {
+            deviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+        }
+
+        //only the features the bindless table relies on are turned on
+        support.features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES };
+        support.features.runtimeDescriptorArray = VK_TRUE;
+        support.features.descriptorBindingPartiallyBound = VK_TRUE;
+        support.features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        support.features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        support.features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        support.features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        support.features.pNext = featuresChain;
+        featuresChain = &support.features;
+    }
+
+    static void FillFreeSlots(uint32_t count,
+        std::vector<uint32_t>& freeSlots)
+    {
+        //slots are handed out from the back, so the lowest index goes first
+        freeSlots.resize(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            freeSlots[i] = count - 1 - i;
+        }
+    }
+
+    bool CreateBindlessTable(VkDevice device,
+        const DescriptorIndexingSupport& support,
+        uint32_t sampledImagesCount,
+        uint32_t storageBuffersCount,
+        BindlessTable& table)
+    {
+        if (!support.supported)
+        {
+            WARN_LOG("Descriptor indexing is not enabled, bindless table is unavailable");
+            return false;
+        }
+
+        table.sampledImagesCount = MinLimit(sampledImagesCount, support.maxSampledImages);
+        table.storageBuffersCount = MinLimit(storageBuffersCount, support.maxStorageBuffers);
+
+        //both bindings together must also fit into the resources a single stage may access
+        table.sampledImagesCount = MinLimit(table.sampledImagesCount, support.maxPerStageResources);
+        table.storageBuffersCount = MinLimit(table.storageBuffersCount, support.maxPerStageResources - table.sampledImagesCount);
+
+        std::vector<VkDescriptorSetLayoutBinding> bindings =
+        {
+            {
+                bindlessTextureBinding,
+                VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                table.sampledImagesCount,
+                VK_SHADER_STAGE_ALL,
+                nullptr
+            },
+            {
+                bindlessBufferBinding,
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                table.storageBuffersCount,
+                VK_SHADER_STAGE_ALL,
+                nullptr
+            },
+        };
+
+        //slots can be written while the set is bound and need not all hold valid descriptors
+        VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+        std::vector<VkDescriptorBindingFlags> flags = { bindingFlags, bindingFlags };
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo =
+        {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+            nullptr,
+            static_cast<uint32_t>(flags.size()),
+            flags.data()
+        };
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo =
+        {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            &bindingFlagsInfo,
+            VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+            static_cast<uint32_t>(bindings.size()),
+            bindings.data()
+        };
+
+        VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &table.layout));
+
+        std::vector<VkDescriptorPoolSize> poolSizes =
+        {
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, table.sampledImagesCount },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, table.storageBuffersCount },
+        };
+
+        VkDescriptorPoolCreateInfo poolInfo =
+        {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            nullptr,
+            VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+            1,
+            static_cast<uint32_t>(poolSizes.size()),
+            poolSizes.data()
+        };
+
+        VK_CHECK_RESULT(vkCreateDescriptorPool(device, &poolInfo, nullptr, &table.pool));
+
+        std::vector<VkDescriptorSet> sets;
+        AllocateDescriptorSets(device, table.pool, { table.layout }, sets);
+        table.set = sets[0];
+
+        FillFreeSlots(table.sampledImagesCount, table.freeSampledImageSlots);
+        FillFreeSlots(table.storageBuffersCount, table.freeStorageBufferSlots);
+        return true;
+    }
+
+    uint32_t AddTextureToBindlessTable(VkDevice device,
+        BindlessTable& table,
+        VkSampler sampler,
+        VkImageView imageView,
+        VkImageLayout imageLayout)
+    {
+        if (table.freeSampledImageSlots.empty())
+        {
+            WARN_LOG("Bindless texture table is full");
+            return invalidBindlessSlot;
+        }
+
+        uint32_t slot = table.freeSampledImageSlots.back();
+        table.freeSampledImageSlots.pop_back();
+
+        ImageDescriptorInfo imageDescriptor =
+        {
+            table.set,
+            bindlessTextureBinding,
+            slot,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            { { sampler, imageView, imageLayout } }
+        };
+
+        UpdateDescriptorSets(device, { imageDescriptor }, {}, {}, {});
+        return slot;
+    }
+
+    uint32_t AddBufferToBindlessTable(VkDevice device,
+        BindlessTable& table,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        VkDeviceSize range)
+    {
+        if (table.freeStorageBufferSlots.empty())
+        {
+            WARN_LOG("Bindless buffer table is full");
+            return invalidBindlessSlot;
+        }
+
+        uint32_t slot = table.freeStorageBufferSlots.back();
+        table.freeStorageBufferSlots.pop_back();
+
+        BufferDescriptorInfo bufferDescriptor =
+        {
+            table.set,
+            bindlessBufferBinding,
+            slot,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            { { buffer, offset, range } }
+        };
+
+        UpdateDescriptorSets(device, {}, { bufferDescriptor }, {}, {});
+        return slot;
+    }
+
+    //a slot may only be released once no frame in flight indexes it anymore
+    void RemoveTextureFromBindlessTable(BindlessTable& table,
+        uint32_t slot)
+    {
+        table.freeSampledImageSlots.push_back(slot);
+    }
+
+    void RemoveBufferFromBindlessTable(BindlessTable& table,
+        uint32_t slot)
+    {
+        table.freeStorageBufferSlots.push_back(slot);
+    }
+
+    void BindBindlessTable(VkCommandBuffer commandBuffer,
+        VkPipelineBindPoint pipelineType,
+        VkPipelineLayout layout,
+        uint32_t setIndex,
+        const BindlessTable& table)
+    {
+        BindDescitorSets(commandBuffer, pipelineType, layout, setIndex, { table.set }, {});
+    }
+
+    void DestroyBindlessTable(VkDevice device,
+        BindlessTable& table)
+    {
+        DestroyDescriptorPool(device, table.pool);
+        DestroyDescriptorSetLayout(device, table.layout);
+        table.freeSampledImageSlots.clear();
+        table.freeStorageBufferSlots.clear();
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "Instance.h"
+#include "PhysicalDevice.h"
+#include "DescriptorSets.h"
+#include "Library/Structs/Descriptors.h"
+
+namespace vk
+{
+    static const uint32_t invalidBindlessSlot = UINT32_MAX;
+
+    bool CheckDescriptorIndexingSupport(VkPhysicalDevice physicalDevice,
+        DescriptorIndexingSupport& support);
+
+    void EnableDescriptorIndexing(DescriptorIndexingSupport& support,
+        std::vector<const char*>& deviceExtensions,
+        void*& featuresChain);
+
+    bool CreateBindlessTable(VkDevice device,
+        const DescriptorIndexingSupport& support,
+        uint32_t sampledImagesCount,
+        uint32_t storageBuffersCount,
+        BindlessTable& table);
+
+    uint32_t AddTextureToBindlessTable(VkDevice device,
+        BindlessTable& table,
+        VkSampler sampler,
+        VkImageView imageView,
+        VkImageLayout imageLayout);
+
+    uint32_t AddBufferToBindlessTable(VkDevice device,
+        BindlessTable& table,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        VkDeviceSize range);
+
+    void RemoveTextureFromBindlessTable(BindlessTable& table,
+        uint32_t slot);
+
+    void RemoveBufferFromBindlessTable(BindlessTable& table,
+        uint32_t slot);
+
+    void BindBindlessTable(VkCommandBuffer commandBuffer,
+        VkPipelineBindPoint pipelineType,
+        VkPipelineLayout layout,
+        uint32_t setIndex,
+        const BindlessTable& table);
+
+    void DestroyBindlessTable(VkDevice device,
+        BindlessTable& table);
+}
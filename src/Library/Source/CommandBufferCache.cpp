@@ -0,0 +1,126 @@
+#include "CommandBufferCache.h"
+
+namespace vk
+{
+    //a slot is only ever submitted from its own frame in flight, so it is idle again once that frame is waited on
+    static uint32_t GetCacheSlot(const CommandBufferCache& cache,
+        uint32_t frameIndex,
+        uint32_t imageIndex)
+    {
+        return frameIndex * cache.imagesCount + imageIndex;
+    }
+
+    static void DestroyCachedFramebuffers(VkDevice device,
+        CommandBufferCache& cache)
+    {
+        for (auto& framebuffer : cache.framebuffers)
+        {
+            if (framebuffer != VK_NULL_HANDLE)
+            {
+                DestroyFramebuffer(device, framebuffer);
+                framebuffer = VK_NULL_HANDLE;
+            }
+        }
+    }
+
+    void CreateCommandBufferCache(VkDevice device,
+        uint32_t queueFamily,
+        uint32_t framesCount,
+        CommandBufferCache& cache)
+    {
+        //cached buffers are re-recorded one at a time, so this pool keeps the per-buffer reset
+        cache = {};
+        cache.framesCount = framesCount;
+        cache.version = 1;
+        CreateCommandPool(device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, queueFamily, cache.pool);
+    }
+
+    void ResizeCommandBufferCache(VkDevice device,
+        CommandBufferCache& cache,
+        uint32_t imagesCount)
+    {
+        //framebuffers reference the swapchain and depth views, which are recreated with the swapchain
+        DestroyCachedFramebuffers(device, cache);
+
+        uint32_t slotsCount = cache.framesCount * imagesCount;
+        if (cache.commandBuffers.size() < slotsCount)
+        {
+            std::vector<VkCommandBuffer> allocated;
+            AllocateCommandBuffers(device, cache.pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                slotsCount - static_cast<uint32_t>(cache.commandBuffers.size()), allocated);
+            cache.commandBuffers.insert(cache.commandBuffers.end(), allocated.begin(), allocated.end());
+        }
+
+        cache.imagesCount = imagesCount;
+        cache.framebuffers.assign(slotsCount, VK_NULL_HANDLE);
+        cache.recordedVersions.assign(slotsCount, 0);
+        InvalidateCommandBufferCache(cache);
+    }
+
+    void InvalidateCommandBufferCache(CommandBufferCache& cache)
+    {
+        //every slot holding an older version is re-recorded the next time it is used
+        cache.version++;
+    }
+
+    void GetCachedFramebuffer(VkDevice device,
+        CommandBufferCache& cache,
+        uint32_t frameIndex,
+        uint32_t imageIndex,
+        VkRenderPass renderPass,
+        const std::vector<VkImageView>& attachments,
+        VkExtent2D size,
+        VkFramebuffer& framebuffer)
+    {
+        uint32_t slot = GetCacheSlot(cache, frameIndex, imageIndex);
+        if (cache.framebuffers[slot] == VK_NULL_HANDLE)
+        {
+            CreateFramebuffer(device, renderPass, attachments, size.width, size.height, 1, cache.framebuffers[slot]);
+        }
+        framebuffer = cache.framebuffers[slot];
+    }
+
+    bool GetCachedCommandBuffer(CommandBufferCache& cache,
+        uint32_t frameIndex,
+        uint32_t imageIndex,
+        std::function<bool(VkCommandBuffer, VkFramebuffer)> recordCommandBuffer,
+        VkCommandBuffer& commandBuffer)
+    {
+        uint32_t slot = GetCacheSlot(cache, frameIndex, imageIndex);
+        commandBuffer = cache.commandBuffers[slot];
+
+        if (cache.recordedVersions[slot] == cache.version)
+        {
+            cache.stats.reused++;
+            return true;
+        }
+
+        ResetCommandBuffer(commandBuffer, false);
+        if (!recordCommandBuffer(commandBuffer, cache.framebuffers[slot]))
+        {
+            cache.recordedVersions[slot] = 0;
+            return false;
+        }
+
+        cache.recordedVersions[slot] = cache.version;
+        cache.stats.recorded++;
+        return true;
+    }
+
+    void GetCommandBufferCacheStats(const CommandBufferCache& cache,
+        CommandBufferCacheStats& stats)
+    {
+        stats = cache.stats;
+    }
+
+    void DestroyCommandBufferCache(VkDevice device,
+        CommandBufferCache& cache)
+    {
+        DestroyCachedFramebuffers(device, cache);
+        if (cache.pool != VK_NULL_HANDLE)
+        {
+            DestroyCommandPool(device, cache.pool);
+        }
+        cache = {};
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "CommandBuffer.h"
+#include "RenderPass.h"
+#include "Library/Structs/CommandPool.h"
+
+namespace vk
+{
+    void CreateCommandBufferCache(VkDevice device,
+        uint32_t queueFamily,
+        uint32_t framesCount,
+        CommandBufferCache& cache);
+
+    void ResizeCommandBufferCache(VkDevice device,
+        CommandBufferCache& cache,
+        uint32_t imagesCount);
+
+    void InvalidateCommandBufferCache(CommandBufferCache& cache);
+
+    void GetCachedFramebuffer(VkDevice device,
+        CommandBufferCache& cache,
+        uint32_t frameIndex,
+        uint32_t imageIndex,
+        VkRenderPass renderPass,
+        const std::vector<VkImageView>& attachments,
+        VkExtent2D size,
+        VkFramebuffer& framebuffer);
+
+    bool GetCachedCommandBuffer(CommandBufferCache& cache,
+        uint32_t frameIndex,
+        uint32_t imageIndex,
+        std::function<bool(VkCommandBuffer, VkFramebuffer)> recordCommandBuffer,
+        VkCommandBuffer& commandBuffer);
+
+    void GetCommandBufferCacheStats(const CommandBufferCache& cache,
+        CommandBufferCacheStats& stats);
+
+    void DestroyCommandBufferCache(VkDevice device,
+        CommandBufferCache& cache);
+}
@@ -0,0 +1,128 @@
+#include "DescriptorAllocator.h"
+
+namespace vk
+{
+    static const uint32_t maxSetsPerPool = 4096;
+
+    static void CreatePoolFromRatios(VkDevice device,
+        uint32_t setsCount,
+        const std::vector<DescriptorPoolRatio>& ratios,
+        VkDescriptorPool& pool)
+    {
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        for (auto& ratio : ratios)
+        {
+            uint32_t descriptorsCount = static_cast<uint32_t>(ratio.descriptorsPerSet * setsCount);
+            poolSizes.push_back({ ratio.type, descriptorsCount > 0 ? descriptorsCount : 1 });
+        }
+
+        CreateDescriptorPool(device, false, setsCount, poolSizes, pool);
+    }
+
+    static VkDescriptorPool GetReadyPool(VkDevice device,
+        DescriptorAllocator& allocator)
+    {
+        if (!allocator.readyPools.empty())
+        {
+            return allocator.readyPools.back();
+        }
+
+        //each new pool is larger than the previous one, so a busy allocator settles on few pools
+        allocator.setsPerPool = allocator.setsPerPool + allocator.setsPerPool / 2;
+        if (allocator.setsPerPool > maxSetsPerPool)
+        {
+            allocator.setsPerPool = maxSetsPerPool;
+        }
+
+        VkDescriptorPool pool;
+        CreatePoolFromRatios(device, allocator.setsPerPool, allocator.ratios, pool);
+        allocator.readyPools.push_back(pool);
+        return pool;
+    }
+
+    void CreateDescriptorAllocator(VkDevice device,
+        uint32_t setsPerPool,
+        const std::vector<DescriptorPoolRatio>& ratios,
+        DescriptorAllocator& allocator)
+    {
+        allocator.ratios = ratios;
+        allocator.setsPerPool = setsPerPool > 0 ? setsPerPool : 1;
+        allocator.readyPools.clear();
+        allocator.fullPools.clear();
+
+        VkDescriptorPool pool;
+        CreatePoolFromRatios(device, allocator.setsPerPool, allocator.ratios, pool);
+        allocator.readyPools.push_back(pool);
+    }
+
+    bool AllocateDescriptorSetsFromAllocator(VkDevice device,
+        DescriptorAllocator& allocator,
+        const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+        std::vector<VkDescriptorSet>& descriptorSets)
+    {
+        descriptorSets.resize(descriptorSetLayouts.size());
+
+        //a fresh pool is tried once, if that fails too the layouts do not fit the ratios at all
+        for (int attempt = 0; attempt < 2; attempt++)
+        {
+            VkDescriptorSetAllocateInfo allocInfo =
+            {
+                VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                nullptr,
+                GetReadyPool(device, allocator),
+                static_cast<uint32_t>(descriptorSetLayouts.size()),
+                descriptorSetLayouts.data()
+            };
+
+            VkResult result = vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data());
+            if (result == VK_SUCCESS)
+            {
+                return true;
+            }
+
+            if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)
+            {
+                break;
+            }
+
+            allocator.fullPools.push_back(allocator.readyPools.back());
+            allocator.readyPools.pop_back();
+        }
+
+        ERROR_LOG("Could not allocate descriptor sets from descriptor allocator");
+        descriptorSets.clear();
+        return false;
+    }
+
+    void ResetDescriptorAllocator(VkDevice device,
+        DescriptorAllocator& allocator)
+    {
+        for (auto& pool : allocator.readyPools)
+        {
+            ResetDescriptorPool(device, pool);
+        }
+
+        for (auto& pool : allocator.fullPools)
+        {
+            ResetDescriptorPool(device, pool);
+            allocator.readyPools.push_back(pool);
+        }
+        allocator.fullPools.clear();
+    }
+
+    void DestroyDescriptorAllocator(VkDevice device,
+        DescriptorAllocator& allocator)
+    {
+        for (auto& pool : allocator.readyPools)
+        {
+            DestroyDescriptorPool(device, pool);
+        }
+        for (auto& pool : allocator.fullPools)
+        {
+            DestroyDescriptorPool(device, pool);
+        }
+
+        allocator.readyPools.clear();
+        allocator.fullPools.clear();
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "DescriptorSets.h"
+#include "Library/Structs/Descriptors.h"
+
+namespace vk
+{
+    void CreateDescriptorAllocator(VkDevice device,
+        uint32_t setsPerPool,
+        const std::vector<DescriptorPoolRatio>& ratios,
+        DescriptorAllocator& allocator);
+
+    bool AllocateDescriptorSetsFromAllocator(VkDevice device,
+        DescriptorAllocator& allocator,
+        const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+        std::vector<VkDescriptorSet>& descriptorSets);
+
+    void ResetDescriptorAllocator(VkDevice device,
+        DescriptorAllocator& allocator);
+
+    void DestroyDescriptorAllocator(VkDevice device,
+        DescriptorAllocator& allocator);
+}
@@ -0,0 +1,199 @@
+#include "DescriptorLayoutCache.h"
+
+#include <algorithm>
+
+namespace vk
+{
+    uint64_t HashDescriptorSetLayoutBindings(VkDescriptorSetLayoutCreateFlags flags,
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings)
+    {
+        //the same bindings listed in a different order describe the same layout
+        std::vector<VkDescriptorSetLayoutBinding> sortedBindings = bindings;
+        std::sort(sortedBindings.begin(), sortedBindings.end(),
+            [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b)
+            {
+                return a.binding < b.binding;
+            });
+
+        uint64_t hash = HashValue(flags, 14695981039346656037ull);
+        hash = HashValue(sortedBindings.size(), hash);
+        for (auto& binding : sortedBindings)
+        {
+            hash = HashValue(binding.binding, hash);
+            hash = HashValue(binding.descriptorType, hash);
+            hash = HashValue(binding.descriptorCount, hash);
+            hash = HashValue(binding.stageFlags, hash);
+            if (binding.pImmutableSamplers != nullptr)
+            {
+                hash = HashBytes(binding.pImmutableSamplers, binding.descriptorCount * sizeof(VkSampler), hash);
+            }
+        }
+
+        return hash;
+    }
+
+    void GetOrCreateDescriptorSetLayout(VkDevice device,
+        DescriptorLayoutCache& cache,
+        VkDescriptorSetLayoutCreateFlags flags,
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout& descriptorSetLayout)
+    {
+        uint64_t key = HashDescriptorSetLayoutBindings(flags, bindings);
+        auto found = cache.setLayouts.find(key);
+        if (found != cache.setLayouts.end())
+        {
+            descriptorSetLayout = found->second;
+            return;
+        }
+
+        CreateDescriptorSetLayout(device, flags, bindings, descriptorSetLayout);
+        cache.setLayouts[key] = descriptorSetLayout;
+        cache.setLayoutFlags[descriptorSetLayout] = flags;
+    }
+
+    void GetOrCreatePipelineLayout(VkDevice device,
+        DescriptorLayoutCache& cache,
+        const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+        const std::vector<VkPushConstantRange>& pushConstantRanges,
+        VkPipelineLayout& pipelineLayout)
+    {
+        uint64_t pushConstantsKey = HashBytes(pushConstantRanges.data(),
+            pushConstantRanges.size() * sizeof(VkPushConstantRange));
+
+        //set layouts come from the cache, so equal handles mean equal layouts
+        uint64_t key = HashBytes(descriptorSetLayouts.data(),
+            descriptorSetLayouts.size() * sizeof(VkDescriptorSetLayout), pushConstantsKey);
+
+        auto found = cache.pipelineLayouts.find(key);
+        if (found != cache.pipelineLayouts.end())
+        {
+            pipelineLayout = found->second;
+            return;
+        }
+
+        CreatePipelineLayout(device, descriptorSetLayouts, pushConstantRanges, pipelineLayout);
+        cache.pipelineLayouts[key] = pipelineLayout;
+        cache.pipelineLayoutInfos[pipelineLayout] = { descriptorSetLayouts, pushConstantsKey };
+    }
+
+    bool GetOrCreateDescriptorUpdateTemplate(VkDevice device,
+        DescriptorLayoutCache& cache,
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout descriptorSetLayout,
+        VkDescriptorUpdateTemplate& updateTemplate)
+    {
+        //layouts are shared by equal bindings in any order, the template reads its data in binding number order
+        auto found = cache.updateTemplates.find(descriptorSetLayout);
+        if (found != cache.updateTemplates.end())
+        {
+            updateTemplate = found->second;
+            return true;
+        }
+
+        //push descriptor layouts have no sets to update, they are written with PushDescriptorSet instead
+        auto flags = cache.setLayoutFlags.find(descriptorSetLayout);
+        if (flags != cache.setLayoutFlags.end() && (flags->second & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR))
+        {
+            WARN_LOG("Descriptor set update templates cannot be created for push descriptor layouts");
+            updateTemplate = VK_NULL_HANDLE;
+            return false;
+        }
+
+        std::vector<VkDescriptorUpdateTemplateEntry> entries;
+        SpecifyDescriptorUpdateTemplateEntries(bindings, entries);
+        CreateDescriptorUpdateTemplate(device, entries, descriptorSetLayout, updateTemplate);
+        cache.updateTemplates[descriptorSetLayout] = updateTemplate;
+        return true;
+    }
+
+    bool ArePipelineLayoutsCompatibleForSet(const DescriptorLayoutCache& cache,
+        VkPipelineLayout first,
+        VkPipelineLayout second,
+        uint32_t setIndex)
+    {
+        if (first == second)
+        {
+            return true;
+        }
+
+        auto firstInfo = cache.pipelineLayoutInfos.find(first);
+        auto secondInfo = cache.pipelineLayoutInfos.find(second);
+        if (firstInfo == cache.pipelineLayoutInfos.end() || secondInfo == cache.pipelineLayoutInfos.end())
+        {
+            return false;
+        }
+
+        //layouts are compatible for a set when push constants and all sets up to it match
+        const PipelineLayoutInfo& a = firstInfo->second;
+        const PipelineLayoutInfo& b = secondInfo->second;
+        if (a.pushConstantsKey != b.pushConstantsKey ||
+            a.setLayouts.size() <= setIndex || b.setLayouts.size() <= setIndex)
+        {
+            return false;
+        }
+
+        return std::equal(a.setLayouts.begin(), a.setLayouts.begin() + setIndex + 1, b.setLayouts.begin());
+    }
+
+    bool BindDescriptorSetsIfChanged(VkCommandBuffer commandBuffer,
+        const DescriptorLayoutCache& cache,
+        VkPipelineBindPoint pipelineType,
+        VkPipelineLayout layout,
+        uint32_t indexForFirstSet,
+        const std::vector<VkDescriptorSet>& sets,
+        const std::vector<uint32_t>& dynamicOffsets,
+        BoundDescriptorSets& boundSets)
+    {
+        uint32_t lastSet = indexForFirstSet + static_cast<uint32_t>(sets.size());
+
+        //dynamic offsets may change between draws, so those sets are always bound again
+        bool alreadyBound = dynamicOffsets.empty() && !sets.empty() &&
+            boundSets.layout != VK_NULL_HANDLE && boundSets.sets.size() >= lastSet &&
+            ArePipelineLayoutsCompatibleForSet(cache, boundSets.layout, layout, lastSet - 1) &&
+            std::equal(sets.begin(), sets.end(), boundSets.sets.begin() + indexForFirstSet);
+
+        if (alreadyBound)
+        {
+            return false;
+        }
+
+        BindDescitorSets(commandBuffer, pipelineType, layout, indexForFirstSet, sets, dynamicOffsets);
+
+        //sets below the first one survive only when the layouts agree on them
+        if (boundSets.layout == VK_NULL_HANDLE || indexForFirstSet == 0 ||
+            !ArePipelineLayoutsCompatibleForSet(cache, boundSets.layout, layout, indexForFirstSet - 1))
+        {
+            boundSets.sets.assign(indexForFirstSet, VK_NULL_HANDLE);
+        }
+
+        //bindings past the updated range are disturbed, so they are forgotten
+        boundSets.sets.resize(lastSet, VK_NULL_HANDLE);
+        std::copy(sets.begin(), sets.end(), boundSets.sets.begin() + indexForFirstSet);
+        boundSets.layout = layout;
+        return true;
+    }
+
+    void DestroyDescriptorLayoutCache(VkDevice device,
+        DescriptorLayoutCache& cache)
+    {
+        for (auto& entry : cache.updateTemplates)
+        {
+            DestroyDescriptorUpdateTemplate(device, entry.second);
+        }
+        cache.updateTemplates.clear();
+
+        for (auto& entry : cache.pipelineLayouts)
+        {
+            DestroyPipelineLayout(device, entry.second);
+        }
+        for (auto& entry : cache.setLayouts)
+        {
+            DestroyDescriptorSetLayout(device, entry.second);
+        }
+
+        cache.pipelineLayouts.clear();
+        cache.pipelineLayoutInfos.clear();
+        cache.setLayouts.clear();
+        cache.setLayoutFlags.clear();
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "DescriptorSets.h"
+#include "Pipeline.h"
+#include "Library/Structs/Descriptors.h"
+#include "Library/Common/Tools.h"
+
+namespace vk
+{
+    uint64_t HashDescriptorSetLayoutBindings(VkDescriptorSetLayoutCreateFlags flags,
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+
+    void GetOrCreateDescriptorSetLayout(VkDevice device,
+        DescriptorLayoutCache& cache,
+        VkDescriptorSetLayoutCreateFlags flags,
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout& descriptorSetLayout);
+
+    void GetOrCreatePipelineLayout(VkDevice device,
+        DescriptorLayoutCache& cache,
+        const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+        const std::vector<VkPushConstantRange>& pushConstantRanges,
+        VkPipelineLayout& pipelineLayout);
+
+    bool GetOrCreateDescriptorUpdateTemplate(VkDevice device,
+        DescriptorLayoutCache& cache,
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout descriptorSetLayout,
+        VkDescriptorUpdateTemplate& updateTemplate);
+
+    bool ArePipelineLayoutsCompatibleForSet(const DescriptorLayoutCache& cache,
+        VkPipelineLayout first,
+        VkPipelineLayout second,
+        uint32_t setIndex);
+
+    bool BindDescriptorSetsIfChanged(VkCommandBuffer commandBuffer,
+        const DescriptorLayoutCache& cache,
+        VkPipelineBindPoint pipelineType,
+        VkPipelineLayout layout,
+        uint32_t indexForFirstSet,
+        const std::vector<VkDescriptorSet>& sets,
+        const std::vector<uint32_t>& dynamicOffsets,
+        BoundDescriptorSets& boundSets);
+
+    void DestroyDescriptorLayoutCache(VkDevice device,
+        DescriptorLayoutCache& cache);
+}
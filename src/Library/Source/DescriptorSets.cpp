@@ -1,5 +1,7 @@
 #include "DescriptorSets.h"
 
+#include <algorithm>
+
 namespace vk
 {
     void CreateSampler(VkDevice device, 
@@ -285,12 +287,20 @@ namespace vk
     void CreateDescriptorSetLayout(VkDevice device, 
         const std::vector<VkDescriptorSetLayoutBinding>& bindings, 
         VkDescriptorSetLayout& descriptorSetLayout)
+    {
+        CreateDescriptorSetLayout(device, 0, bindings, descriptorSetLayout);
+    }
+
+    void CreateDescriptorSetLayout(VkDevice device,
+        VkDescriptorSetLayoutCreateFlags flags,
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout& descriptorSetLayout)
     {
         VkDescriptorSetLayoutCreateInfo descriptorInfo =
         {
             VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
             nullptr,
-            0,
+            flags,
             static_cast<uint32_t>(bindings.size()),
             bindings.data()
         };
@@ -399,19 +409,19 @@ namespace vk
             );
         }
 
-        for (auto& copy : copyDescriptors)
+        for (auto& copy : copyInfo)
         {
             copyDescriptors.push_back(
                 {
                     VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET,
                     nullptr,
-                    copy.srcSet,
+                    copy.srcDescriptorSet,
                     copy.srcBinding,
                     copy.srcArrayElement,
-                    copy.dstSet,
+                    copy.dstDescriptorSet,
                     copy.dstBinding,
                     copy.dstArrayElement,
-                    copy.descriptorCount
+                    copy.descriptorsCount
                 }
             );
         }
@@ -420,6 +430,87 @@ namespace vk
             static_cast<uint32_t>(copyDescriptors.size()), copyDescriptors.data());
     }
 
+    size_t SpecifyDescriptorUpdateTemplateEntries(const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        std::vector<VkDescriptorUpdateTemplateEntry>& entries)
+    {
+        //descriptor infos are packed one after another by binding number, whatever order the bindings are listed in,
+        //so every caller of a cached layout shares one data layout
+        std::vector<VkDescriptorSetLayoutBinding> sortedBindings = bindings;
+        std::sort(sortedBindings.begin(), sortedBindings.end(),
+            [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b)
+            {
+                return a.binding < b.binding;
+            });
+
+        entries.clear();
+        size_t offset = 0;
+        for (auto& binding : sortedBindings)
+        {
+            size_t stride;
+            switch (binding.descriptorType)
+            {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                stride = sizeof(VkDescriptorImageInfo);
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                stride = sizeof(VkBufferView);
+                break;
+            default:
+                stride = sizeof(VkDescriptorBufferInfo);
+                break;
+            }
+
+            entries.push_back(
+                {
+                    binding.binding,
+                    0,
+                    binding.descriptorCount,
+                    binding.descriptorType,
+                    offset,
+                    stride
+                }
+            );
+            offset += stride * binding.descriptorCount;
+        }
+
+        return offset;
+    }
+
+    void CreateDescriptorUpdateTemplate(VkDevice device,
+        const std::vector<VkDescriptorUpdateTemplateEntry>& entries,
+        VkDescriptorSetLayout descriptorSetLayout,
+        VkDescriptorUpdateTemplate& updateTemplate)
+    {
+        VkDescriptorUpdateTemplateCreateInfo templateInfo =
+        {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+            nullptr,
+            0,
+            static_cast<uint32_t>(entries.size()),
+            entries.data(),
+            VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,
+            descriptorSetLayout,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            VK_NULL_HANDLE,
+            0
+        };
+
+        VK_CHECK_RESULT(vkCreateDescriptorUpdateTemplate(device, &templateInfo, nullptr, &updateTemplate));
+    }
+
+    void UpdateDescriptorSetWithTemplate(VkDevice device,
+        VkDescriptorSet descriptorSet,
+        VkDescriptorUpdateTemplate updateTemplate,
+        const void* data)
+    {
+        vkUpdateDescriptorSetWithTemplate(device, descriptorSet, updateTemplate, data);
+    }
+
     void BindDescitorSets(VkCommandBuffer commandBuffer, 
         VkPipelineBindPoint pipelineType, 
         VkPipelineLayout layout, 
@@ -548,6 +639,12 @@ namespace vk
         vkDestroyDescriptorPool(device, pool, nullptr);
     }
 
+    void DestroyDescriptorUpdateTemplate(VkDevice device,
+        VkDescriptorUpdateTemplate& updateTemplate)
+    {
+        vkDestroyDescriptorUpdateTemplate(device, updateTemplate, nullptr);
+    }
+
     void DestroyDescriptorSetLayout(VkDevice device, 
         VkDescriptorSetLayout& layout)
     {
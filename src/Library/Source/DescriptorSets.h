@@ -141,6 +141,11 @@ namespace vk
         const std::vector<VkDescriptorSetLayoutBinding>& bindings,
         VkDescriptorSetLayout& descriptorSetLayout);
 
+    void CreateDescriptorSetLayout(VkDevice device,
+        VkDescriptorSetLayoutCreateFlags flags,
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout& descriptorSetLayout);
+
     void CreateDescriptorPool(VkDevice device,
         bool freeIndividualSets,
         uint32_t maxSetsCount,
@@ -158,6 +163,19 @@ namespace vk
         const std::vector<TexelBufferDescriptorInfo>& texelInfo,
         const std::vector<CopyDescriptorInfo>& copyInfo);
 
+    size_t SpecifyDescriptorUpdateTemplateEntries(const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        std::vector<VkDescriptorUpdateTemplateEntry>& entries);
+
+    void CreateDescriptorUpdateTemplate(VkDevice device,
+        const std::vector<VkDescriptorUpdateTemplateEntry>& entries,
+        VkDescriptorSetLayout descriptorSetLayout,
+        VkDescriptorUpdateTemplate& updateTemplate);
+
+    void UpdateDescriptorSetWithTemplate(VkDevice device,
+        VkDescriptorSet descriptorSet,
+        VkDescriptorUpdateTemplate updateTemplate,
+        const void* data);
+
     void BindDescitorSets(VkCommandBuffer commandBuffer,
         VkPipelineBindPoint pipelineType,
         VkPipelineLayout layout,
@@ -189,6 +207,9 @@ namespace vk
     void DestroyDescriptorPool(VkDevice device,
         VkDescriptorPool& pool);
 
+    void DestroyDescriptorUpdateTemplate(VkDevice device,
+        VkDescriptorUpdateTemplate& updateTemplate);
+
     void DestroyDescriptorSetLayout(VkDevice device,
         VkDescriptorSetLayout& layout);
 
@@ -0,0 +1,353 @@
+#include "DrawList.h"
+
+#include <algorithm>
+
+namespace vk
+{
+    uint64_t MakeDrawSortKey(uint32_t pass,
+        uint32_t pipeline,
+        uint32_t material,
+        float depth)
+    {
+        //pass, pipeline and material take the high bits so state changes are grouped before depth is considered
+        uint64_t depthBits = depth <= 0.0f ? 0 : depth >= 1.0f ? 0xFFFFFF : static_cast<uint64_t>(depth * 0xFFFFFF);
+        return (static_cast<uint64_t>(pass & 0xF) << 60) |
+            (static_cast<uint64_t>(pipeline & 0xFFFF) << 44) |
+            (static_cast<uint64_t>(material & 0xFFFFF) << 24) |
+            depthBits;
+    }
+
+    void ResetDrawList(DrawList& list)
+    {
+        //clearing keeps the capacity, so steady frames do not allocate
+        list.materials.clear();
+        list.packets.clear();
+        list.pushConstantData.clear();
+        list.order.clear();
+    }
+
+    uint32_t AddDrawMaterial(DrawList& list,
+        VkPipelineBindPoint bindPoint,
+        VkPipelineLayout layout,
+        uint32_t firstSet,
+        const std::vector<VkDescriptorSet>& sets,
+        const std::vector<uint32_t>& dynamicOffsets)
+    {
+        list.materials.push_back({ bindPoint, layout, firstSet, sets, dynamicOffsets });
+        return static_cast<uint32_t>(list.materials.size() - 1);
+    }
+
+    void AddDrawPacket(DrawList& list,
+        DrawPacket packet,
+        const void* pushConstants)
+    {
+        //push constant bytes are copied into the list, packets only keep where they start
+        packet.pushConstantData = static_cast<uint32_t>(list.pushConstantData.size());
+        if (pushConstants != nullptr && packet.pushConstantSize > 0)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(pushConstants);
+            list.pushConstantData.insert(list.pushConstantData.end(), bytes, bytes + packet.pushConstantSize);
+        }
+        else
+        {
+            packet.pushConstantSize = 0;
+        }
+
+        list.packets.push_back(packet);
+    }
+
+    void SortDrawList(DrawList& list)
+    {
+        uint32_t count = static_cast<uint32_t>(list.packets.size());
+        list.order.resize(count);
+        list.sortScratch.resize(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            list.order[i] = { list.packets[i].sortKey, i };
+        }
+
+        if (count == 0)
+        {
+            return;
+        }
+
+        //least significant digit radix sort, stable so equal keys keep their submission order
+        for (uint32_t shift = 0; shift < 64; shift += 8)
+        {
+            uint32_t histogram[256] = {};
+            for (auto& entry : list.order)
+            {
+                histogram[(entry.key >> shift) & 0xFF]++;
+            }
+
+            //a byte shared by every key would leave the order untouched
+            if (histogram[(list.order[0].key >> shift) & 0xFF] == count)
+            {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (auto& bucket : histogram)
+            {
+                uint32_t bucketSize = bucket;
+                bucket = offset;
+                offset += bucketSize;
+            }
+
+            for (auto& entry : list.order)
+            {
+                list.sortScratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+            }
+            list.order.swap(list.sortScratch);
+        }
+    }
+
+    void BeginDrawRecorder(VkCommandBuffer commandBuffer,
+        DrawRecorder& recorder)
+    {
+        recorder = {};
+        recorder.commandBuffer = commandBuffer;
+        recorder.material = UINT32_MAX;
+    }
+
+    static void BindDrawPacketState(DrawRecorder& recorder,
+        const DescriptorLayoutCache& cache,
+        const DrawList& list,
+        const DrawPacket& packet)
+    {
+        const DrawMaterial& material = list.materials[packet.material];
+        DrawRecorderStats& stats = recorder.stats;
+
+        if (packet.pipeline != recorder.pipeline)
+        {
+            BindPipelineObject(recorder.commandBuffer, material.bindPoint, packet.pipeline);
+            recorder.pipeline = packet.pipeline;
+            stats.pipelineBinds++;
+        }
+        else
+        {
+            stats.pipelineBindsSkipped++;
+        }
+
+        //the same material keeps its dynamic offsets, other materials may still match through the layout cache
+        if (!material.sets.empty())
+        {
+            bool sameMaterial = packet.material == recorder.material && recorder.boundSets.layout == material.layout;
+            if (!sameMaterial && BindDescriptorSetsIfChanged(recorder.commandBuffer, cache, material.bindPoint,
+                material.layout, material.firstSet, material.sets, material.dynamicOffsets, recorder.boundSets))
+            {
+                stats.descriptorBinds++;
+            }
+            else
+            {
+                stats.descriptorBindsSkipped++;
+            }
+            recorder.material = packet.material;
+        }
+
+        if (packet.vertexBuffer != VK_NULL_HANDLE)
+        {
+            if (packet.vertexBuffer != recorder.vertexBuffer || packet.vertexBufferOffset != recorder.vertexBufferOffset)
+            {
+                BindVertexBuffers(recorder.commandBuffer, 0, { { packet.vertexBuffer, packet.vertexBufferOffset } });
+                recorder.vertexBuffer = packet.vertexBuffer;
+                recorder.vertexBufferOffset = packet.vertexBufferOffset;
+                stats.vertexBufferBinds++;
+            }
+            else
+            {
+                stats.vertexBufferBindsSkipped++;
+            }
+        }
+
+        if (packet.indexBuffer != VK_NULL_HANDLE)
+        {
+            if (packet.indexBuffer != recorder.indexBuffer || packet.indexBufferOffset != recorder.indexBufferOffset ||
+                packet.indexType != recorder.indexType)
+            {
+                BindIndexBuffer(recorder.commandBuffer, packet.indexBuffer, packet.indexBufferOffset, packet.indexType);
+                recorder.indexBuffer = packet.indexBuffer;
+                recorder.indexBufferOffset = packet.indexBufferOffset;
+                recorder.indexType = packet.indexType;
+                stats.indexBufferBinds++;
+            }
+            else
+            {
+                stats.indexBufferBindsSkipped++;
+            }
+        }
+
+        if (packet.pushConstantSize > 0)
+        {
+            const unsigned char* data = list.pushConstantData.data() + packet.pushConstantData;
+            bool samePushConstants = recorder.pushConstantLayout == material.layout &&
+                recorder.pushConstantStages == packet.pushConstantStages &&
+                recorder.pushConstantOffset == packet.pushConstantOffset &&
+                recorder.pushConstantData.size() == packet.pushConstantSize &&
+                std::equal(recorder.pushConstantData.begin(), recorder.pushConstantData.end(), data);
+
+            if (!samePushConstants)
+            {
+                recorder.pushConstantData.assign(data, data + packet.pushConstantSize);
+                recorder.pushConstantLayout = material.layout;
+                recorder.pushConstantStages = packet.pushConstantStages;
+                recorder.pushConstantOffset = packet.pushConstantOffset;
+                ProvidePushConstants(recorder.commandBuffer, material.layout, packet.pushConstantStages,
+                    packet.pushConstantOffset, packet.pushConstantSize, recorder.pushConstantData.data());
+                stats.pushConstants++;
+            }
+            else
+            {
+                stats.pushConstantsSkipped++;
+            }
+        }
+    }
+
+    //packets drawn by one indirect call must not differ in anything that is bound between draws
+    static bool CanShareIndirectDraw(const DrawList& list,
+        const DrawPacket& first,
+        const DrawPacket& packet)
+    {
+        return packet.pipeline == first.pipeline &&
+            packet.material == first.material &&
+            packet.vertexBuffer == first.vertexBuffer &&
+            packet.vertexBufferOffset == first.vertexBufferOffset &&
+            packet.indexBuffer == first.indexBuffer &&
+            packet.indexBufferOffset == first.indexBufferOffset &&
+            packet.indexType == first.indexType &&
+            packet.pushConstantStages == first.pushConstantStages &&
+            packet.pushConstantOffset == first.pushConstantOffset &&
+            packet.pushConstantSize == first.pushConstantSize &&
+            std::equal(list.pushConstantData.begin() + packet.pushConstantData,
+                list.pushConstantData.begin() + packet.pushConstantData + packet.pushConstantSize,
+                list.pushConstantData.begin() + first.pushConstantData);
+    }
+
+    static void DrawPacketDirectly(DrawRecorder& recorder,
+        const DrawPacket& packet)
+    {
+        if (packet.indexBuffer != VK_NULL_HANDLE)
+        {
+            DrawIndexedGeometry(recorder.commandBuffer, packet.count, packet.instanceCount, packet.first,
+                static_cast<uint32_t>(packet.vertexOffset), packet.firstInstance);
+        }
+        else
+        {
+            DrawGeometry(recorder.commandBuffer, packet.count, packet.instanceCount, packet.first, packet.firstInstance);
+        }
+        recorder.stats.draws++;
+    }
+
+    void RecordDrawList(DrawRecorder& recorder,
+        const DescriptorLayoutCache& cache,
+        const DrawList& list)
+    {
+        //material indices are local to a list
+        recorder.material = UINT32_MAX;
+
+        for (auto& entry : list.order)
+        {
+            const DrawPacket& packet = list.packets[entry.packet];
+            BindDrawPacketState(recorder, cache, list, packet);
+            DrawPacketDirectly(recorder, packet);
+        }
+    }
+
+    void RecordDrawListIndirect(DrawRecorder& recorder,
+        const DescriptorLayoutCache& cache,
+        const DrawList& list,
+        LinearAllocator& indirectAllocator)
+    {
+        recorder.material = UINT32_MAX;
+        bool firstInstance = GetIndirectDrawSupport().drawIndirectFirstInstance;
+
+        uint32_t count = static_cast<uint32_t>(list.order.size());
+        uint32_t begin = 0;
+        while (begin < count)
+        {
+            const DrawPacket& first = list.packets[list.order[begin].packet];
+            BindDrawPacketState(recorder, cache, list, first);
+
+            //sorting put packets with the same state next to each other, each run becomes one bucket
+            uint32_t end = begin + 1;
+            while (end < count && CanShareIndirectDraw(list, first, list.packets[list.order[end].packet]))
+            {
+                end++;
+            }
+
+            bool indexed = first.indexBuffer != VK_NULL_HANDLE;
+            uint32_t drawCount = end - begin;
+            VkDeviceSize stride = indexed ? sizeof(VkDrawIndexedIndirectCommand) : sizeof(VkDrawIndirectCommand);
+
+            bool writable = true;
+            for (uint32_t i = begin; i < end && writable; i++)
+            {
+                writable = firstInstance || list.packets[list.order[i].packet].firstInstance == 0;
+            }
+
+            LinearAllocation allocation;
+            if (!writable || !AllocateFromLinearAllocator(indirectAllocator, stride * drawCount, 4, allocation))
+            {
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    DrawPacketDirectly(recorder, list.packets[list.order[i].packet]);
+                }
+                begin = end;
+                continue;
+            }
+
+            for (uint32_t i = 0; i < drawCount; i++)
+            {
+                const DrawPacket& packet = list.packets[list.order[begin + i].packet];
+                if (indexed)
+                {
+                    static_cast<VkDrawIndexedIndirectCommand*>(allocation.data)[i] =
+                    {
+                        packet.count,
+                        packet.instanceCount,
+                        packet.first,
+                        packet.vertexOffset,
+                        packet.firstInstance
+                    };
+                }
+                else
+                {
+                    static_cast<VkDrawIndirectCommand*>(allocation.data)[i] =
+                    {
+                        packet.count,
+                        packet.instanceCount,
+                        packet.first,
+                        packet.firstInstance
+                    };
+                }
+            }
+
+            if (indexed)
+            {
+                DrawIndexedGeometryIndirect(recorder.commandBuffer, allocation.buffer, allocation.offset, drawCount);
+            }
+            else
+            {
+                DrawGeometryIndirect(recorder.commandBuffer, allocation.buffer, allocation.offset, drawCount);
+            }
+            recorder.stats.draws += drawCount;
+            recorder.stats.indirectDraws++;
+            begin = end;
+        }
+    }
+
+    void LogDrawRecorderStats(const DrawRecorderStats& stats)
+    {
+        INFO_LOG("Draws: " + std::to_string(stats.draws) + ", indirect calls " + std::to_string(stats.indirectDraws));
+        INFO_LOG("Pipeline binds: " + std::to_string(stats.pipelineBinds) + ", skipped " +
+            std::to_string(stats.pipelineBindsSkipped));
+        INFO_LOG("Descriptor set binds: " + std::to_string(stats.descriptorBinds) + ", skipped " +
+            std::to_string(stats.descriptorBindsSkipped));
+        INFO_LOG("Vertex buffer binds: " + std::to_string(stats.vertexBufferBinds) + ", skipped " +
+            std::to_string(stats.vertexBufferBindsSkipped));
+        INFO_LOG("Index buffer binds: " + std::to_string(stats.indexBufferBinds) + ", skipped " +
+            std::to_string(stats.indexBufferBindsSkipped));
+        INFO_LOG("Push constant updates: " + std::to_string(stats.pushConstants) + ", skipped " +
+            std::to_string(stats.pushConstantsSkipped));
+    }
+}
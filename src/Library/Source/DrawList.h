@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "Drawing.h"
+#include "Pipeline.h"
+#include "DescriptorLayoutCache.h"
+#include "LinearAllocator.h"
+#include "Library/Structs/DrawList.h"
+
+namespace vk
+{
+    uint64_t MakeDrawSortKey(uint32_t pass,
+        uint32_t pipeline,
+        uint32_t material,
+        float depth);
+
+    void ResetDrawList(DrawList& list);
+
+    uint32_t AddDrawMaterial(DrawList& list,
+        VkPipelineBindPoint bindPoint,
+        VkPipelineLayout layout,
+        uint32_t firstSet,
+        const std::vector<VkDescriptorSet>& sets,
+        const std::vector<uint32_t>& dynamicOffsets);
+
+    void AddDrawPacket(DrawList& list,
+        DrawPacket packet,
+        const void* pushConstants);
+
+    void SortDrawList(DrawList& list);
+
+    void BeginDrawRecorder(VkCommandBuffer commandBuffer,
+        DrawRecorder& recorder);
+
+    void RecordDrawList(DrawRecorder& recorder,
+        const DescriptorLayoutCache& cache,
+        const DrawList& list);
+
+    void RecordDrawListIndirect(DrawRecorder& recorder,
+        const DescriptorLayoutCache& cache,
+        const DrawList& list,
+        LinearAllocator& indirectAllocator);
+
+    void LogDrawRecorderStats(const DrawRecorderStats& stats);
+}
@@ -84,6 +84,101 @@ namespace vk
         vkCmdSetLineWidth(commandBuffer, lineWidth);
     }
 
+    //commands the device does not expose were reported when they were loaded, so recording just skips them
+    template<typename Command, typename... Arguments>
+    static void RecordDynamicStateCommand(Command command,
+        Arguments... arguments)
+    {
+        if (command != nullptr)
+        {
+            command(arguments...);
+        }
+    }
+
+    void SetCullModeDynamically(VkCommandBuffer commandBuffer,
+        VkCullModeFlags cullMode)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetCullMode, commandBuffer, cullMode);
+    }
+
+    void SetFrontFaceDynamically(VkCommandBuffer commandBuffer,
+        VkFrontFace frontFace)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetFrontFace, commandBuffer, frontFace);
+    }
+
+    void SetPrimitiveTopologyDynamically(VkCommandBuffer commandBuffer,
+        VkPrimitiveTopology topology)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetPrimitiveTopology, commandBuffer, topology);
+    }
+
+    void SetDepthTestEnableDynamically(VkCommandBuffer commandBuffer,
+        bool depthTestEnable)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetDepthTestEnable, commandBuffer, depthTestEnable);
+    }
+
+    void SetDepthWriteEnableDynamically(VkCommandBuffer commandBuffer,
+        bool depthWriteEnable)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetDepthWriteEnable, commandBuffer, depthWriteEnable);
+    }
+
+    void SetDepthCompareOpDynamically(VkCommandBuffer commandBuffer,
+        VkCompareOp compareOp)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetDepthCompareOp, commandBuffer, compareOp);
+    }
+
+    void SetDepthBoundsTestEnableDynamically(VkCommandBuffer commandBuffer,
+        bool depthBoundsTestEnable)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetDepthBoundsTestEnable, commandBuffer, depthBoundsTestEnable);
+    }
+
+    void SetStencilTestEnableDynamically(VkCommandBuffer commandBuffer,
+        bool stencilTestEnable)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetStencilTestEnable, commandBuffer, stencilTestEnable);
+    }
+
+    void SetStencilOpDynamically(VkCommandBuffer commandBuffer,
+        VkStencilFaceFlags faceMask,
+        VkStencilOp failOp,
+        VkStencilOp passOp,
+        VkStencilOp depthFailOp,
+        VkCompareOp compareOp)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetStencilOp, commandBuffer, faceMask, failOp, passOp, depthFailOp, compareOp);
+    }
+
+    void SetDepthBiasEnableDynamically(VkCommandBuffer commandBuffer,
+        bool depthBiasEnable)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetDepthBiasEnable, commandBuffer, depthBiasEnable);
+    }
+
+    void SetPrimitiveRestartEnableDynamically(VkCommandBuffer commandBuffer,
+        bool primitiveRestartEnable)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetPrimitiveRestartEnable, commandBuffer, primitiveRestartEnable);
+    }
+
+    void SetRasterizerDiscardEnableDynamically(VkCommandBuffer commandBuffer,
+        bool rasterizerDiscardEnable)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetRasterizerDiscardEnable, commandBuffer, rasterizerDiscardEnable);
+    }
+
+#ifdef VK_EXT_extended_dynamic_state3
+    void SetPolygonModeDynamically(VkCommandBuffer commandBuffer,
+        VkPolygonMode polygonMode)
+    {
+        RecordDynamicStateCommand(GetExtendedDynamicStateFunctions().cmdSetPolygonMode, commandBuffer, polygonMode);
+    }
+#endif
+
     void SetDepthBiasStateDynamically(VkCommandBuffer commandBuffer,
         float constant,
         float clamp,
@@ -117,6 +212,58 @@ namespace vk
         vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
     }
 
+    void DrawGeometryIndirect(VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        uint32_t drawCount)
+    {
+        //without multi draw indirect every record takes its own call, the parameters still come from the buffer
+        uint32_t stride = sizeof(VkDrawIndirectCommand);
+        uint32_t maxDrawCount = GetIndirectDrawSupport().multiDrawIndirect ? GetIndirectDrawSupport().maxDrawIndirectCount : 1;
+        for (uint32_t first = 0; first < drawCount; first += maxDrawCount)
+        {
+            uint32_t count = drawCount - first < maxDrawCount ? drawCount - first : maxDrawCount;
+            vkCmdDrawIndirect(commandBuffer, buffer, offset + static_cast<VkDeviceSize>(first) * stride, count, stride);
+        }
+    }
+
+    void DrawIndexedGeometryIndirect(VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        uint32_t drawCount)
+    {
+        uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+        uint32_t maxDrawCount = GetIndirectDrawSupport().multiDrawIndirect ? GetIndirectDrawSupport().maxDrawIndirectCount : 1;
+        for (uint32_t first = 0; first < drawCount; first += maxDrawCount)
+        {
+            uint32_t count = drawCount - first < maxDrawCount ? drawCount - first : maxDrawCount;
+            vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset + static_cast<VkDeviceSize>(first) * stride, count, stride);
+        }
+    }
+
+    void DrawGeometryIndirectCount(VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        VkBuffer countBuffer,
+        VkDeviceSize countOffset,
+        uint32_t maxDrawCount)
+    {
+        //callers check IsDrawIndirectCountAvailable, the count lives in gpu memory so there is no cpu fallback
+        GetIndirectDrawFunctions().cmdDrawIndirectCount(commandBuffer, buffer, offset, countBuffer, countOffset,
+            maxDrawCount, sizeof(VkDrawIndirectCommand));
+    }
+
+    void DrawIndexedGeometryIndirectCount(VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        VkBuffer countBuffer,
+        VkDeviceSize countOffset,
+        uint32_t maxDrawCount)
+    {
+        GetIndirectDrawFunctions().cmdDrawIndexedIndirectCount(commandBuffer, buffer, offset, countBuffer, countOffset,
+            maxDrawCount, sizeof(VkDrawIndexedIndirectCommand));
+    }
+
     void DispatchComputeWork(VkCommandBuffer commandBuffer,
         uint32_t x,
         uint32_t y,
@@ -229,23 +376,85 @@ namespace vk
         EndCommandBufferRecordingOperation(commandBuffer);
     }
 
-    void RecordCommandBufferOnMultipleThreads(std::vector<CommandBufferRecordingThreadParameters>& threadParams,
+    void RecordSecondaryCommandBuffersInParallel(VkDevice device,
+        JobSystem& jobSystem,
+        FrameCommandPool& framePool,
+        VkRenderPass renderPass,
+        uint32_t subpass,
+        VkFramebuffer framebuffer,
+        uint32_t drawCount,
+        uint32_t chunkSize,
+        std::function<void(VkCommandBuffer, uint32_t, uint32_t)> recordDraws,
+        std::vector<VkCommandBuffer>& secondaryCommandBuffers)
+    {
+        //without an explicit chunk size the draws are spread evenly over every thread that can record
+        if (chunkSize == 0)
+        {
+            uint32_t threadsCount = GetJobThreadsCount(jobSystem);
+            chunkSize = (drawCount + threadsCount - 1) / threadsCount;
+            chunkSize = chunkSize > 0 ? chunkSize : 1;
+        }
+
+        uint32_t chunksCount = (drawCount + chunkSize - 1) / chunkSize;
+        secondaryCommandBuffers.assign(chunksCount, VK_NULL_HANDLE);
+
+        JobCounter recording;
+        for (uint32_t chunk = 0; chunk < chunksCount; chunk++)
+        {
+            SubmitJob(jobSystem, [&, chunk](uint32_t threadIndex)
+            {
+                VkCommandBufferInheritanceInfo inheritanceInfo =
+                {
+                    VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+                    nullptr,
+                    renderPass,
+                    subpass,
+                    framebuffer,
+                    VK_FALSE,
+                    0,
+                    0
+                };
+
+                //every thread allocates from its own pool, secondaries do not inherit dynamic state so recordDraws sets it
+                VkCommandBuffer commandBuffer;
+                AcquireFrameCommandBuffer(device, framePool, threadIndex, VK_COMMAND_BUFFER_LEVEL_SECONDARY, commandBuffer);
+                BeginCommandBufferRecordingOperation(commandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                    VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT, &inheritanceInfo);
+
+                uint32_t firstDraw = chunk * chunkSize;
+                uint32_t remaining = drawCount - firstDraw;
+                recordDraws(commandBuffer, firstDraw, remaining < chunkSize ? remaining : chunkSize);
+
+                EndCommandBufferRecordingOperation(commandBuffer);
+                secondaryCommandBuffers[chunk] = commandBuffer;
+            }, &recording);
+        }
+
+        WaitForJobCounter(jobSystem, recording);
+    }
+
+    void RecordCommandBufferOnMultipleThreads(JobSystem& jobSystem,
+        std::vector<CommandBufferRecordingThreadParameters>& threadParams,
         VkQueue queue,
         std::vector<WaitSemaphoreInfo> waitInfos,
         std::vector<VkSemaphore> signalSemaphores,
         VkFence fence)
     {
-        std::vector<std::thread> threads(threadParams.size());
-        for (int i = 0; i < threadParams.size(); i++)
+        //recording runs on the persistent workers instead of threads spawned for every call
+        JobCounter recording;
+        for (auto& params : threadParams)
         {
-            threads[i] = std::thread(threadParams[i].recordingFunction, threadParams[i].commandBuffer);
+            SubmitJob(jobSystem, [&params](uint32_t)
+            {
+                params.recordingFunction(params.commandBuffer);
+            }, &recording);
         }
+        WaitForJobCounter(jobSystem, recording);
 
-        std::vector<VkCommandBuffer> commandBuffers(threadParams.size());
-        for (int i = 0; i < threadParams.size(); i++)
+        std::vector<VkCommandBuffer> commandBuffers;
+        for (auto& params : threadParams)
         {
-            threads[i].join();
-            commandBuffers.push_back(threadParams[i].commandBuffer);
+            commandBuffers.push_back(params.commandBuffer);
         }
 
         SubmitCommandBuffersToQueue(queue, waitInfos, commandBuffers, signalSemaphores, fence);
@@ -268,7 +477,10 @@ namespace vk
         VkFramebuffer framebuffer)
     {
         uint32_t imageIndex;
-        AcquireSwapchainImage(device, swapchain, imageAcquiredSemaphore, VK_NULL_HANDLE, imageIndex);
+        if (!AcquireSwapchainImage(device, swapchain, imageAcquiredSemaphore, VK_NULL_HANDLE, imageIndex))
+        {
+            return;
+        }
 
         std::vector<VkImageView> attachments = { swapchainImageViews[imageIndex] };
         if (depthAttachment != VK_NULL_HANDLE)
@@ -298,32 +510,165 @@ namespace vk
         PresentImage(presentQueue, { readyToPresentSemaphore }, { presentInfo });
     }
 
-    void IncreasePerformanceThroughtIncreasingTheNumberOfSeparatelyRenderedFrames(VkDevice device,
-        VkQueue graphicsQueue,
+    //the acquired image signals its semaphore even when the frame is not drawn, so an empty submission still waits
+    //on it and the frame moves on, the image itself is only handed back once the swapchain is recreated
+    static void SkipScheduledFrame(VkDevice device,
+        FrameScheduler& scheduler,
+        VkSemaphore imageAcquiredSemaphore)
+    {
+        std::vector<WaitSemaphoreInfo> binaryWaits =
+        {
+            { imageAcquiredSemaphore, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT }
+        };
+
+        if (!SubmitScheduledFrame(device, scheduler, {}, binaryWaits, {}, {}))
+        {
+            WARN_LOG("Failed to release the semaphore of a skipped frame");
+        }
+
+        EndScheduledFrame(scheduler);
+    }
+
+    void RenderScheduledFrame(VkDevice device,
+        FrameScheduler& scheduler,
         VkQueue presentQueue,
         VkSwapchainKHR swapchain,
         VkExtent2D swapchainSize,
         std::vector<VkImageView>& swapchainImages,
         VkRenderPass renderPass,
-        std::vector<WaitSemaphoreInfo>& waitInfos,
+        const std::vector<TimelineWaitInfo>& timelineWaits,
         std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)> recordCommandBuffer,
         std::vector<FrameResources>& frameResources)
     {
-        static uint32_t frameIndex = 0;
-        FrameResources& currentFrame = frameResources[frameIndex];
+        if (!WaitForScheduledFrame(device, scheduler, 2000000000))
+        {
+            return;
+        }
+
+        FrameResources& currentFrame = frameResources[scheduler.frameIndex];
+
+        //the gpu is done with this frame, so its transient descriptor sets, command buffers and framebuffer are released
+        ResetDescriptorAllocator(device, currentFrame.descriptorAllocator);
+        ResetFrameCommandPool(device, currentFrame.commandPool);
+        AcquireFrameCommandBuffer(device, currentFrame.commandPool, GetFrameCommandPoolCallerThread(currentFrame.commandPool),
+            VK_COMMAND_BUFFER_LEVEL_PRIMARY, currentFrame.commandBuffer);
+        if (currentFrame.framebuffer != VK_NULL_HANDLE)
+        {
+            DestroyFramebuffer(device, currentFrame.framebuffer);
+            currentFrame.framebuffer = VK_NULL_HANDLE;
+        }
+
+        //nothing waits on the semaphore of a failed acquire, so the frame is simply tried again
+        uint32_t imageIndex;
+        if (!AcquireSwapchainImage(device, swapchain, currentFrame.imageAcquiredSemaphore, VK_NULL_HANDLE, imageIndex))
+        {
+            return;
+        }
+
+        //frames recorded through a render graph pass no render pass, the graph caches its own framebuffers
+        if (renderPass != VK_NULL_HANDLE)
+        {
+            std::vector<VkImageView> attachments = { swapchainImages[imageIndex] };
+            if (currentFrame.depthAttachment != VK_NULL_HANDLE)
+            {
+                attachments.push_back(currentFrame.depthAttachment);
+            }
 
-        if (!WaitForFences(device, { currentFrame.drawingFinishedFence }, false, 2000000000))
+            CreateFramebuffer(device, renderPass, attachments, swapchainSize.width, swapchainSize.height,
+                1, currentFrame.framebuffer);
+        }
+
+        if (!recordCommandBuffer(currentFrame.commandBuffer, imageIndex, currentFrame.framebuffer))
         {
+            WARN_LOG("Failed to record command buffer");
+            SkipScheduledFrame(device, scheduler, currentFrame.imageAcquiredSemaphore);
             return;
         }
 
-        ResetFences(device, { currentFrame.drawingFinishedFence });
+        //swapchain acquire and present only work with binary semaphores, everything else waits on timelines
+        std::vector<WaitSemaphoreInfo> binaryWaits =
+        {
+            { currentFrame.imageAcquiredSemaphore, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT }
+        };
+
+        if (!SubmitScheduledFrame(device, scheduler, timelineWaits, binaryWaits, { currentFrame.commandBuffer },
+            { currentFrame.readyToPresentSemaphore }))
+        {
+            SkipScheduledFrame(device, scheduler, currentFrame.imageAcquiredSemaphore);
+            return;
+        }
 
-        PrepareSingleFrameOfAnimation(device, graphicsQueue, presentQueue, swapchain, swapchainSize,
-            swapchainImages, currentFrame.depthAttachment, waitInfos, currentFrame.imageAcquiredSemaphore,
-            currentFrame.readyToPresentSemaphore, currentFrame.drawingFinishedFence, recordCommandBuffer, 
-            currentFrame.commandBuffer, renderPass, currentFrame.framebuffer);
+        PresentInfo presentInfo = { swapchain, imageIndex };
+        PresentImage(presentQueue, { currentFrame.readyToPresentSemaphore }, { presentInfo });
+
+        EndScheduledFrame(scheduler);
+    }
+
+    void RenderCachedFrame(VkDevice device,
+        FrameScheduler& scheduler,
+        CommandBufferCache& cache,
+        VkQueue presentQueue,
+        VkSwapchainKHR swapchain,
+        VkExtent2D swapchainSize,
+        std::vector<VkImageView>& swapchainImages,
+        VkRenderPass renderPass,
+        const std::vector<TimelineWaitInfo>& timelineWaits,
+        std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)> recordCommandBuffer,
+        std::vector<FrameResources>& frameResources)
+    {
+        if (!WaitForScheduledFrame(device, scheduler, 2000000000))
+        {
+            return;
+        }
+
+        //the frame's descriptor allocator is not reset, cached recordings may still reference its sets
+        FrameResources& currentFrame = frameResources[scheduler.frameIndex];
+
+        //nothing waits on the semaphore of a failed acquire, so the frame is simply tried again
+        uint32_t imageIndex;
+        if (!AcquireSwapchainImage(device, swapchain, currentFrame.imageAcquiredSemaphore, VK_NULL_HANDLE, imageIndex))
+        {
+            return;
+        }
+
+        std::vector<VkImageView> attachments = { swapchainImages[imageIndex] };
+        if (currentFrame.depthAttachment != VK_NULL_HANDLE)
+        {
+            attachments.push_back(currentFrame.depthAttachment);
+        }
+
+        VkFramebuffer framebuffer;
+        GetCachedFramebuffer(device, cache, scheduler.frameIndex, imageIndex, renderPass, attachments,
+            swapchainSize, framebuffer);
+
+        //only a stale slot calls back into the sample, otherwise the last recording is submitted as it is
+        VkCommandBuffer commandBuffer;
+        if (!GetCachedCommandBuffer(cache, scheduler.frameIndex, imageIndex,
+            [&](VkCommandBuffer cachedCommandBuffer, VkFramebuffer cachedFramebuffer)
+        {
+            return recordCommandBuffer(cachedCommandBuffer, imageIndex, cachedFramebuffer);
+        }, commandBuffer))
+        {
+            WARN_LOG("Failed to record command buffer");
+            SkipScheduledFrame(device, scheduler, currentFrame.imageAcquiredSemaphore);
+            return;
+        }
+
+        std::vector<WaitSemaphoreInfo> binaryWaits =
+        {
+            { currentFrame.imageAcquiredSemaphore, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT }
+        };
+
+        if (!SubmitScheduledFrame(device, scheduler, timelineWaits, binaryWaits, { commandBuffer },
+            { currentFrame.readyToPresentSemaphore }))
+        {
+            SkipScheduledFrame(device, scheduler, currentFrame.imageAcquiredSemaphore);
+            return;
+        }
+
+        PresentInfo presentInfo = { swapchain, imageIndex };
+        PresentImage(presentQueue, { currentFrame.readyToPresentSemaphore }, { presentInfo });
 
-        frameIndex = (frameIndex + 1) % frameResources.size();
+        EndScheduledFrame(scheduler);
     }
 }
\ No newline at end of file
@@ -7,12 +7,19 @@
 #include "CommandBuffer.h"
 #include "Resources.h"
 #include "DescriptorSets.h"
+#include "DescriptorAllocator.h"
 #include "RenderPass.h"
 #include "Pipeline.h"
 #include "Swapchain.h"
+#include "DynamicState.h"
+#include "IndirectDraw.h"
+#include "FrameScheduler.h"
+#include "FrameCommandPool.h"
+#include "CommandBufferCache.h"
 #include "Library/Structs/Pipeline.h"
 #include "Library/Common/Tools.h"
 #include "Library/Common/MeshLoader.h"
+#include "Library/Common/JobSystem.h"
 #include "Library/Structs/Semaphore.h"
 
 namespace vk
@@ -60,6 +67,51 @@ namespace vk
     void SetLineWidthDynamically(VkCommandBuffer commandBuffer,
         float lineWidth);
 
+    void SetCullModeDynamically(VkCommandBuffer commandBuffer,
+        VkCullModeFlags cullMode);
+
+    void SetFrontFaceDynamically(VkCommandBuffer commandBuffer,
+        VkFrontFace frontFace);
+
+    void SetPrimitiveTopologyDynamically(VkCommandBuffer commandBuffer,
+        VkPrimitiveTopology topology);
+
+    void SetDepthTestEnableDynamically(VkCommandBuffer commandBuffer,
+        bool depthTestEnable);
+
+    void SetDepthWriteEnableDynamically(VkCommandBuffer commandBuffer,
+        bool depthWriteEnable);
+
+    void SetDepthCompareOpDynamically(VkCommandBuffer commandBuffer,
+        VkCompareOp compareOp);
+
+    void SetDepthBoundsTestEnableDynamically(VkCommandBuffer commandBuffer,
+        bool depthBoundsTestEnable);
+
+    void SetStencilTestEnableDynamically(VkCommandBuffer commandBuffer,
+        bool stencilTestEnable);
+
+    void SetStencilOpDynamically(VkCommandBuffer commandBuffer,
+        VkStencilFaceFlags faceMask,
+        VkStencilOp failOp,
+        VkStencilOp passOp,
+        VkStencilOp depthFailOp,
+        VkCompareOp compareOp);
+
+    void SetDepthBiasEnableDynamically(VkCommandBuffer commandBuffer,
+        bool depthBiasEnable);
+
+    void SetPrimitiveRestartEnableDynamically(VkCommandBuffer commandBuffer,
+        bool primitiveRestartEnable);
+
+    void SetRasterizerDiscardEnableDynamically(VkCommandBuffer commandBuffer,
+        bool rasterizerDiscardEnable);
+
+#ifdef VK_EXT_extended_dynamic_state3
+    void SetPolygonModeDynamically(VkCommandBuffer commandBuffer,
+        VkPolygonMode polygonMode);
+#endif
+
     void SetDepthBiasStateDynamically(VkCommandBuffer commandBuffer,
         float constant,
         float clamp,
@@ -81,6 +133,30 @@ namespace vk
         uint32_t vertexOffset,
         uint32_t firstInstance);
 
+    void DrawGeometryIndirect(VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        uint32_t drawCount);
+
+    void DrawIndexedGeometryIndirect(VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        uint32_t drawCount);
+
+    void DrawGeometryIndirectCount(VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        VkBuffer countBuffer,
+        VkDeviceSize countOffset,
+        uint32_t maxDrawCount);
+
+    void DrawIndexedGeometryIndirectCount(VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        VkBuffer countBuffer,
+        VkDeviceSize countOffset,
+        uint32_t maxDrawCount);
+
     void DispatchComputeWork(VkCommandBuffer commandBuffer,
         uint32_t x,
         uint32_t y,
@@ -107,7 +183,19 @@ namespace vk
         uint32_t instanceCount,
         uint32_t firstInstance);
 
-    void RecordCommandBufferOnMultipleThreads(std::vector<CommandBufferRecordingThreadParameters>& threadParams,
+    void RecordSecondaryCommandBuffersInParallel(VkDevice device,
+        JobSystem& jobSystem,
+        FrameCommandPool& framePool,
+        VkRenderPass renderPass,
+        uint32_t subpass,
+        VkFramebuffer framebuffer,
+        uint32_t drawCount,
+        uint32_t chunkSize,
+        std::function<void(VkCommandBuffer, uint32_t, uint32_t)> recordDraws,
+        std::vector<VkCommandBuffer>& secondaryCommandBuffers);
+
+    void RecordCommandBufferOnMultipleThreads(JobSystem& jobSystem,
+        std::vector<CommandBufferRecordingThreadParameters>& threadParams,
         VkQueue queue,
         std::vector<WaitSemaphoreInfo> waitInfos,
         std::vector<VkSemaphore> signalSemaphores,
@@ -129,14 +217,26 @@ namespace vk
         VkRenderPass renderPass,
         VkFramebuffer framebuffer);
 
-    void IncreasePerformanceThroughtIncreasingTheNumberOfSeparatelyRenderedFrames(VkDevice device,
-        VkQueue graphicsQueue,
+    void RenderScheduledFrame(VkDevice device,
+        FrameScheduler& scheduler,
         VkQueue presentQueue,
         VkSwapchainKHR swapchain,
         VkExtent2D swapchainSize,
         std::vector<VkImageView>& swapchainImages,
         VkRenderPass renderPass,
-        std::vector<WaitSemaphoreInfo>& waitInfos,
+        const std::vector<TimelineWaitInfo>& timelineWaits,
+        std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)> recordCommandBuffer,
+        std::vector<FrameResources>& frameResources);
+
+    void RenderCachedFrame(VkDevice device,
+        FrameScheduler& scheduler,
+        CommandBufferCache& cache,
+        VkQueue presentQueue,
+        VkSwapchainKHR swapchain,
+        VkExtent2D swapchainSize,
+        std::vector<VkImageView>& swapchainImages,
+        VkRenderPass renderPass,
+        const std::vector<TimelineWaitInfo>& timelineWaits,
         std::function<bool(VkCommandBuffer, uint32_t, VkFramebuffer)> recordCommandBuffer,
         std::vector<FrameResources>& frameResources);
 }
\ No newline at end of file
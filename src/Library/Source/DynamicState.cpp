@@ -0,0 +1,215 @@
+#include "DynamicState.h"
+
+namespace vk
+{
+    //the framework drives a single device, so its command entry points are kept here
+    static ExtendedDynamicStateFunctions extendedDynamicStateFunctions = {};
+
+    bool CheckExtendedDynamicStateSupport(VkPhysicalDevice physicalDevice,
+        ExtendedDynamicStateSupport& support)
+    {
+        support = {};
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+        //feature structures can only be queried through vkGetPhysicalDeviceFeatures2
+        uint32_t instanceVersion = GetSupportedInstanceVersion();
+        uint32_t version = instanceVersion < properties.apiVersion ? instanceVersion : properties.apiVersion;
+        if (version < VK_API_VERSION_1_1)
+        {
+            return false;
+        }
+
+        std::vector<VkExtensionProperties> availableExtensions;
+        if (!CheckAvailableDeviceExtensions(physicalDevice, availableExtensions))
+        {
+            return false;
+        }
+
+        support.core = version >= VK_API_VERSION_1_3;
+        support.features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT };
+        support.features2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT };
+
+        void* featuresChain = nullptr;
+        if (IsExtensionSupported(availableExtensions, VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME))
+        {
+            support.features.pNext = featuresChain;
+            featuresChain = &support.features;
+        }
+        if (IsExtensionSupported(availableExtensions, VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME))
+        {
+            support.features2.pNext = featuresChain;
+            featuresChain = &support.features2;
+        }
+#ifdef VK_EXT_extended_dynamic_state3
+        support.features3 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT };
+        if (IsExtensionSupported(availableExtensions, VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME))
+        {
+            support.features3.pNext = featuresChain;
+            featuresChain = &support.features3;
+        }
+#endif
+
+        VkPhysicalDeviceFeatures2 features =
+        {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            featuresChain
+        };
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+        //the first two extensions are core functionality of 1.3
+        support.extendedDynamicState = support.core || support.features.extendedDynamicState;
+        support.extendedDynamicState2 = support.core || support.features2.extendedDynamicState2;
+#ifdef VK_EXT_extended_dynamic_state3
+        support.polygonMode = support.features3.extendedDynamicState3PolygonMode;
+#endif
+
+        return support.extendedDynamicState;
+    }
+
+    void EnableExtendedDynamicState(ExtendedDynamicStateSupport& support,
+        std::vector<const char*>& deviceExtensions,
+        void*& featuresChain)
+    {
+        if (!support.core && support.extendedDynamicState)
+        {
+            deviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+            support.features.pNext = featuresChain;
+            featuresChain = &support.features;
+        }
+
+        if (!support.core && support.extendedDynamicState2)
+        {
+            deviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+            support.features2.pNext = featuresChain;
+            featuresChain = &support.features2;
+        }
+
+#ifdef VK_EXT_extended_dynamic_state3
+        //only the polygon mode is used, so the remaining dynamic state 3 features stay disabled
+        if (support.polygonMode)
+        {
+            deviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+            support.features3 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT };
+            support.features3.extendedDynamicState3PolygonMode = VK_TRUE;
+            support.features3.pNext = featuresChain;
+            featuresChain = &support.features3;
+        }
+#endif
+    }
+
+    static PFN_vkVoidFunction LoadDynamicStateFunction(VkDevice device,
+        bool core,
+        const char* coreName,
+        const char* extensionName)
+    {
+        PFN_vkVoidFunction function = vkGetDeviceProcAddr(device, core ? coreName : extensionName);
+        if (function == nullptr)
+        {
+            std::string name = core ? coreName : extensionName;
+            WARN_LOG("Could not load " + name);
+        }
+        return function;
+    }
+
+    void LoadExtendedDynamicStateFunctions(VkDevice device,
+        const ExtendedDynamicStateSupport& support)
+    {
+        extendedDynamicStateFunctions = {};
+        ExtendedDynamicStateFunctions& functions = extendedDynamicStateFunctions;
+
+        if (support.extendedDynamicState)
+        {
+            functions.cmdSetCullMode = (PFN_vkCmdSetCullMode)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetCullMode", "vkCmdSetCullModeEXT");
+            functions.cmdSetFrontFace = (PFN_vkCmdSetFrontFace)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetFrontFace", "vkCmdSetFrontFaceEXT");
+            functions.cmdSetPrimitiveTopology = (PFN_vkCmdSetPrimitiveTopology)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetPrimitiveTopology", "vkCmdSetPrimitiveTopologyEXT");
+            functions.cmdSetDepthTestEnable = (PFN_vkCmdSetDepthTestEnable)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetDepthTestEnable", "vkCmdSetDepthTestEnableEXT");
+            functions.cmdSetDepthWriteEnable = (PFN_vkCmdSetDepthWriteEnable)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetDepthWriteEnable", "vkCmdSetDepthWriteEnableEXT");
+            functions.cmdSetDepthCompareOp = (PFN_vkCmdSetDepthCompareOp)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetDepthCompareOp", "vkCmdSetDepthCompareOpEXT");
+            functions.cmdSetDepthBoundsTestEnable = (PFN_vkCmdSetDepthBoundsTestEnable)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetDepthBoundsTestEnable", "vkCmdSetDepthBoundsTestEnableEXT");
+            functions.cmdSetStencilTestEnable = (PFN_vkCmdSetStencilTestEnable)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetStencilTestEnable", "vkCmdSetStencilTestEnableEXT");
+            functions.cmdSetStencilOp = (PFN_vkCmdSetStencilOp)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetStencilOp", "vkCmdSetStencilOpEXT");
+        }
+
+        if (support.extendedDynamicState2)
+        {
+            functions.cmdSetDepthBiasEnable = (PFN_vkCmdSetDepthBiasEnable)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetDepthBiasEnable", "vkCmdSetDepthBiasEnableEXT");
+            functions.cmdSetPrimitiveRestartEnable = (PFN_vkCmdSetPrimitiveRestartEnable)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetPrimitiveRestartEnable", "vkCmdSetPrimitiveRestartEnableEXT");
+            functions.cmdSetRasterizerDiscardEnable = (PFN_vkCmdSetRasterizerDiscardEnable)LoadDynamicStateFunction(device, support.core,
+                "vkCmdSetRasterizerDiscardEnable", "vkCmdSetRasterizerDiscardEnableEXT");
+        }
+
+#ifdef VK_EXT_extended_dynamic_state3
+        if (support.polygonMode)
+        {
+            functions.cmdSetPolygonMode = (PFN_vkCmdSetPolygonModeEXT)LoadDynamicStateFunction(device, false,
+                nullptr, "vkCmdSetPolygonModeEXT");
+        }
+#endif
+    }
+
+    const ExtendedDynamicStateFunctions& GetExtendedDynamicStateFunctions()
+    {
+        return extendedDynamicStateFunctions;
+    }
+
+    bool IsDynamicStateSupported(VkDynamicState state)
+    {
+        const ExtendedDynamicStateFunctions& functions = extendedDynamicStateFunctions;
+        switch (state)
+        {
+        case VK_DYNAMIC_STATE_VIEWPORT:
+        case VK_DYNAMIC_STATE_SCISSOR:
+        case VK_DYNAMIC_STATE_LINE_WIDTH:
+        case VK_DYNAMIC_STATE_DEPTH_BIAS:
+        case VK_DYNAMIC_STATE_BLEND_CONSTANTS:
+        case VK_DYNAMIC_STATE_DEPTH_BOUNDS:
+        case VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK:
+        case VK_DYNAMIC_STATE_STENCIL_WRITE_MASK:
+        case VK_DYNAMIC_STATE_STENCIL_REFERENCE:
+            return true;
+        case VK_DYNAMIC_STATE_CULL_MODE:
+            return functions.cmdSetCullMode != nullptr;
+        case VK_DYNAMIC_STATE_FRONT_FACE:
+            return functions.cmdSetFrontFace != nullptr;
+        case VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY:
+            return functions.cmdSetPrimitiveTopology != nullptr;
+        case VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE:
+            return functions.cmdSetDepthTestEnable != nullptr;
+        case VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE:
+            return functions.cmdSetDepthWriteEnable != nullptr;
+        case VK_DYNAMIC_STATE_DEPTH_COMPARE_OP:
+            return functions.cmdSetDepthCompareOp != nullptr;
+        case VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE:
+            return functions.cmdSetDepthBoundsTestEnable != nullptr;
+        case VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE:
+            return functions.cmdSetStencilTestEnable != nullptr;
+        case VK_DYNAMIC_STATE_STENCIL_OP:
+            return functions.cmdSetStencilOp != nullptr;
+        case VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE:
+            return functions.cmdSetDepthBiasEnable != nullptr;
+        case VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE:
+            return functions.cmdSetPrimitiveRestartEnable != nullptr;
+        case VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE:
+            return functions.cmdSetRasterizerDiscardEnable != nullptr;
+#ifdef VK_EXT_extended_dynamic_state3
+        case VK_DYNAMIC_STATE_POLYGON_MODE_EXT:
+            return functions.cmdSetPolygonMode != nullptr;
+#endif
+        default:
+            return false;
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "Instance.h"
+#include "PhysicalDevice.h"
+#include "Library/Structs/DynamicState.h"
+
+namespace vk
+{
+    bool CheckExtendedDynamicStateSupport(VkPhysicalDevice physicalDevice,
+        ExtendedDynamicStateSupport& support);
+
+    void EnableExtendedDynamicState(ExtendedDynamicStateSupport& support,
+        std::vector<const char*>& deviceExtensions,
+        void*& featuresChain);
+
+    void LoadExtendedDynamicStateFunctions(VkDevice device,
+        const ExtendedDynamicStateSupport& support);
+
+    const ExtendedDynamicStateFunctions& GetExtendedDynamicStateFunctions();
+
+    bool IsDynamicStateSupported(VkDynamicState state);
+}
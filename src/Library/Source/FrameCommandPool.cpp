@@ -0,0 +1,68 @@
+#include "FrameCommandPool.h"
+
+namespace vk
+{
+    void CreateFrameCommandPool(VkDevice device,
+        uint32_t queueFamily,
+        uint32_t threadsCount,
+        FrameCommandPool& framePool)
+    {
+        //buffers are never reset one by one, so the pools go without RESET_COMMAND_BUFFER_BIT
+        framePool.threads.resize(threadsCount);
+        for (auto& thread : framePool.threads)
+        {
+            thread = {};
+            CreateCommandPool(device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, queueFamily, thread.pool);
+        }
+    }
+
+    void ResetFrameCommandPool(VkDevice device,
+        FrameCommandPool& framePool,
+        bool releaseResources)
+    {
+        //one pool reset returns every buffer of the thread to the initial state, they are handed out again in order
+        for (auto& thread : framePool.threads)
+        {
+            ResetCommandPool(device, thread.pool, releaseResources);
+            thread.primary.used = 0;
+            thread.secondary.used = 0;
+        }
+    }
+
+    uint32_t GetFrameCommandPoolCallerThread(const FrameCommandPool& framePool)
+    {
+        //pools follow the job system's thread indices, where the thread that created it comes after the workers
+        return static_cast<uint32_t>(framePool.threads.size()) - 1;
+    }
+
+    void AcquireFrameCommandBuffer(VkDevice device,
+        FrameCommandPool& framePool,
+        uint32_t threadIndex,
+        VkCommandBufferLevel level,
+        VkCommandBuffer& commandBuffer)
+    {
+        //each recording thread only touches its own pool, so no locking is needed
+        ThreadCommandPool& thread = framePool.threads[threadIndex];
+        CommandBufferList& list = level == VK_COMMAND_BUFFER_LEVEL_PRIMARY ? thread.primary : thread.secondary;
+
+        if (list.used == list.buffers.size())
+        {
+            std::vector<VkCommandBuffer> allocated;
+            AllocateCommandBuffers(device, thread.pool, level, 1, allocated);
+            list.buffers.push_back(allocated[0]);
+        }
+
+        commandBuffer = list.buffers[list.used++];
+    }
+
+    void DestroyFrameCommandPool(VkDevice device,
+        FrameCommandPool& framePool)
+    {
+        //destroying a pool frees all of its buffers
+        for (auto& thread : framePool.threads)
+        {
+            DestroyCommandPool(device, thread.pool);
+        }
+        framePool.threads.clear();
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "CommandBuffer.h"
+#include "Library/Structs/CommandPool.h"
+
+namespace vk
+{
+    void CreateFrameCommandPool(VkDevice device,
+        uint32_t queueFamily,
+        uint32_t threadsCount,
+        FrameCommandPool& framePool);
+
+    void ResetFrameCommandPool(VkDevice device,
+        FrameCommandPool& framePool,
+        bool releaseResources = false);
+
+    uint32_t GetFrameCommandPoolCallerThread(const FrameCommandPool& framePool);
+
+    void AcquireFrameCommandBuffer(VkDevice device,
+        FrameCommandPool& framePool,
+        uint32_t threadIndex,
+        VkCommandBufferLevel level,
+        VkCommandBuffer& commandBuffer);
+
+    void DestroyFrameCommandPool(VkDevice device,
+        FrameCommandPool& framePool);
+}
@@ -0,0 +1,438 @@
+#include "FrameScheduler.h"
+
+namespace vk
+{
+    //the framework drives a single device, so its timeline entry points are kept here
+    static TimelineSemaphoreFunctions timelineSemaphoreFunctions = {};
+
+    bool CheckTimelineSemaphoreSupport(VkPhysicalDevice physicalDevice,
+        TimelineSemaphoreSupport& support)
+    {
+        support = {};
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+        uint32_t instanceVersion = GetSupportedInstanceVersion();
+        uint32_t version = instanceVersion < properties.apiVersion ? instanceVersion : properties.apiVersion;
+        if (version < VK_API_VERSION_1_1)
+        {
+            return false;
+        }
+
+        std::vector<VkExtensionProperties> availableExtensions;
+        if (!CheckAvailableDeviceExtensions(physicalDevice, availableExtensions))
+        {
+            return false;
+        }
+
+        support.timelineCore = version >= VK_API_VERSION_1_2;
+        support.synchronization2Core = version >= VK_API_VERSION_1_3;
+        support.timelineFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES };
+        support.synchronization2Features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES };
+
+        void* featuresChain = nullptr;
+        if (support.timelineCore || IsExtensionSupported(availableExtensions, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+        {
+            support.timelineFeatures.pNext = featuresChain;
+            featuresChain = &support.timelineFeatures;
+        }
+        if (support.synchronization2Core || IsExtensionSupported(availableExtensions, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME))
+        {
+            support.synchronization2Features.pNext = featuresChain;
+            featuresChain = &support.synchronization2Features;
+        }
+
+        VkPhysicalDeviceFeatures2 features =
+        {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            featuresChain
+        };
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+        //synchronization2 submissions are only used to signal timelines, so it is pointless without them
+        support.timelineSemaphore = support.timelineFeatures.timelineSemaphore;
+        support.synchronization2 = support.timelineSemaphore && support.synchronization2Features.synchronization2;
+
+        return support.timelineSemaphore;
+    }
+
+    void EnableTimelineSemaphores(TimelineSemaphoreSupport& support,
+        std::vector<const char*>& deviceExtensions,
+        void*& featuresChain)
+    {
+        //both features are optional even where they are core, so they are always enabled through the chain
+        if (support.timelineSemaphore)
+        {
+            if (!support.timelineCore)
+            {
+                deviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+            }
+            support.timelineFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES };
+            support.timelineFeatures.timelineSemaphore = VK_TRUE;
+            support.timelineFeatures.pNext = featuresChain;
+            featuresChain = &support.timelineFeatures;
+        }
+
+        if (support.synchronization2)
+        {
+            if (!support.synchronization2Core)
+            {
+                deviceExtensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+            }
+            support.synchronization2Features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES };
+            support.synchronization2Features.synchronization2 = VK_TRUE;
+            support.synchronization2Features.pNext = featuresChain;
+            featuresChain = &support.synchronization2Features;
+        }
+    }
+
+    static PFN_vkVoidFunction LoadTimelineFunction(VkDevice device,
+        bool core,
+        const char* coreName,
+        const char* extensionName)
+    {
+        PFN_vkVoidFunction function = vkGetDeviceProcAddr(device, core ? coreName : extensionName);
+        if (function == nullptr)
+        {
+            std::string name = core ? coreName : extensionName;
+            WARN_LOG("Could not load " + name);
+        }
+        return function;
+    }
+
+    void LoadTimelineSemaphoreFunctions(VkDevice device,
+        const TimelineSemaphoreSupport& support)
+    {
+        timelineSemaphoreFunctions = {};
+        TimelineSemaphoreFunctions& functions = timelineSemaphoreFunctions;
+
+        if (support.timelineSemaphore)
+        {
+            functions.waitSemaphores = (PFN_vkWaitSemaphores)LoadTimelineFunction(device, support.timelineCore,
+                "vkWaitSemaphores", "vkWaitSemaphoresKHR");
+            functions.signalSemaphore = (PFN_vkSignalSemaphore)LoadTimelineFunction(device, support.timelineCore,
+                "vkSignalSemaphore", "vkSignalSemaphoreKHR");
+            functions.getSemaphoreCounterValue = (PFN_vkGetSemaphoreCounterValue)LoadTimelineFunction(device, support.timelineCore,
+                "vkGetSemaphoreCounterValue", "vkGetSemaphoreCounterValueKHR");
+        }
+
+        if (support.synchronization2)
+        {
+            functions.queueSubmit2 = (PFN_vkQueueSubmit2)LoadTimelineFunction(device, support.synchronization2Core,
+                "vkQueueSubmit2", "vkQueueSubmit2KHR");
+        }
+    }
+
+    bool IsTimelineSemaphoreAvailable()
+    {
+        return timelineSemaphoreFunctions.waitSemaphores != nullptr &&
+            timelineSemaphoreFunctions.getSemaphoreCounterValue != nullptr;
+    }
+
+    void CreateTimelineSemaphore(VkDevice device,
+        uint64_t initialValue,
+        VkSemaphore& semaphore)
+    {
+        VkSemaphoreTypeCreateInfo typeInfo =
+        {
+            VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+            nullptr,
+            VK_SEMAPHORE_TYPE_TIMELINE,
+            initialValue
+        };
+
+        VkSemaphoreCreateInfo semaphoreInfo =
+        {
+            VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+            &typeInfo,
+            0
+        };
+
+        VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore));
+    }
+
+    bool WaitForTimelineValue(VkDevice device,
+        VkSemaphore semaphore,
+        uint64_t value,
+        uint64_t timeout)
+    {
+        VkSemaphoreWaitInfo waitInfo =
+        {
+            VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+            nullptr,
+            0,
+            1,
+            &semaphore,
+            &value
+        };
+
+        VkResult result = timelineSemaphoreFunctions.waitSemaphores(device, &waitInfo, timeout);
+        if (result != VK_SUCCESS)
+        {
+            WARN_LOG("Waiting for timeline value " + std::to_string(value) + " failed");
+            return false;
+        }
+
+        return true;
+    }
+
+    uint64_t GetTimelineValue(VkDevice device,
+        VkSemaphore semaphore)
+    {
+        uint64_t value = 0;
+        VK_CHECK_RESULT(timelineSemaphoreFunctions.getSemaphoreCounterValue(device, semaphore, &value));
+        return value;
+    }
+
+    bool SubmitToQueueTimeline(QueueTimeline& timeline,
+        const std::vector<TimelineWaitInfo>& timelineWaits,
+        const std::vector<WaitSemaphoreInfo>& binaryWaits,
+        const std::vector<VkCommandBuffer>& commandBuffers,
+        const std::vector<VkSemaphore>& binarySignals,
+        uint64_t& signalValue)
+    {
+        if (!IsTimelineSemaphoreAvailable())
+        {
+            WARN_LOG("Timeline semaphores are not available");
+            return false;
+        }
+
+        //every submission on a queue advances its timeline by one, waits on other queues target these values
+        signalValue = timeline.submittedValue + 1;
+
+        if (timelineSemaphoreFunctions.queueSubmit2 != nullptr)
+        {
+            std::vector<VkSemaphoreSubmitInfo> waits;
+            for (auto& wait : timelineWaits)
+            {
+                waits.push_back({ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr,
+                    wait.semaphore, wait.value, wait.stages, 0 });
+            }
+            for (auto& wait : binaryWaits)
+            {
+                waits.push_back({ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr,
+                    wait.Semaphore, 0, wait.WaitingStage, 0 });
+            }
+
+            std::vector<VkCommandBufferSubmitInfo> buffers;
+            for (auto& commandBuffer : commandBuffers)
+            {
+                buffers.push_back({ VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO, nullptr, commandBuffer, 0 });
+            }
+
+            std::vector<VkSemaphoreSubmitInfo> signals =
+            {
+                { VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, timeline.semaphore, signalValue,
+                    VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 }
+            };
+            for (auto& semaphore : binarySignals)
+            {
+                signals.push_back({ VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, nullptr, semaphore, 0,
+                    VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 0 });
+            }
+
+            VkSubmitInfo2 submitInfo =
+            {
+                VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+                nullptr,
+                0,
+                static_cast<uint32_t>(waits.size()),
+                waits.data(),
+                static_cast<uint32_t>(buffers.size()),
+                buffers.data(),
+                static_cast<uint32_t>(signals.size()),
+                signals.data()
+            };
+
+            VK_CHECK_RESULT(timelineSemaphoreFunctions.queueSubmit2(timeline.queue, 1, &submitInfo, VK_NULL_HANDLE));
+        }
+        else
+        {
+            //binary semaphores ignore their entries in the value arrays
+            std::vector<VkSemaphore> waitSemaphores;
+            std::vector<VkPipelineStageFlags> waitStages;
+            std::vector<uint64_t> waitValues;
+            for (auto& wait : timelineWaits)
+            {
+                waitSemaphores.push_back(wait.semaphore);
+                waitStages.push_back(static_cast<VkPipelineStageFlags>(wait.stages));
+                waitValues.push_back(wait.value);
+            }
+            for (auto& wait : binaryWaits)
+            {
+                waitSemaphores.push_back(wait.Semaphore);
+                waitStages.push_back(wait.WaitingStage);
+                waitValues.push_back(0);
+            }
+
+            std::vector<VkSemaphore> signalSemaphores = { timeline.semaphore };
+            std::vector<uint64_t> signalValues = { signalValue };
+            for (auto& semaphore : binarySignals)
+            {
+                signalSemaphores.push_back(semaphore);
+                signalValues.push_back(0);
+            }
+
+            VkTimelineSemaphoreSubmitInfo timelineInfo =
+            {
+                VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+                nullptr,
+                static_cast<uint32_t>(waitValues.size()),
+                waitValues.data(),
+                static_cast<uint32_t>(signalValues.size()),
+                signalValues.data()
+            };
+
+            VkSubmitInfo submitInfo =
+            {
+                VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                &timelineInfo,
+                static_cast<uint32_t>(waitSemaphores.size()),
+                waitSemaphores.data(),
+                waitStages.data(),
+                static_cast<uint32_t>(commandBuffers.size()),
+                commandBuffers.data(),
+                static_cast<uint32_t>(signalSemaphores.size()),
+                signalSemaphores.data()
+            };
+
+            VK_CHECK_RESULT(vkQueueSubmit(timeline.queue, 1, &submitInfo, VK_NULL_HANDLE));
+        }
+
+        timeline.submittedValue = signalValue;
+        return true;
+    }
+
+    TimelineWaitInfo GetQueueTimelineWait(const QueueTimeline& timeline,
+        VkPipelineStageFlags2 stages)
+    {
+        return { timeline.semaphore, timeline.submittedValue, stages };
+    }
+
+    void CreateFrameScheduler(VkDevice device,
+        VkQueue graphicsQueue,
+        uint32_t graphicsFamilyIndex,
+        VkQueue computeQueue,
+        uint32_t computeFamilyIndex,
+        uint32_t framesCount,
+        FrameScheduler& scheduler)
+    {
+        scheduler = {};
+        scheduler.timeline = IsTimelineSemaphoreAvailable();
+        scheduler.graphics = { graphicsQueue, graphicsFamilyIndex, VK_NULL_HANDLE, 0 };
+        scheduler.compute = { computeQueue, computeFamilyIndex, VK_NULL_HANDLE, 0 };
+        scheduler.frameValues.resize(framesCount, 0);
+
+        if (scheduler.timeline)
+        {
+            CreateTimelineSemaphore(device, 0, scheduler.graphics.semaphore);
+            CreateTimelineSemaphore(device, 0, scheduler.compute.semaphore);
+            return;
+        }
+
+        //without timelines every frame in flight falls back to its own fence
+        scheduler.frameFences.resize(framesCount);
+        for (auto& fence : scheduler.frameFences)
+        {
+            CreateVkFence(device, true, fence);
+        }
+    }
+
+    bool WaitForScheduledFrame(VkDevice device,
+        FrameScheduler& scheduler,
+        uint64_t timeout)
+    {
+        scheduler.frameIndex = static_cast<uint32_t>(scheduler.frameNumber % scheduler.frameValues.size());
+
+        if (!scheduler.timeline)
+        {
+            VkFence fence = scheduler.frameFences[scheduler.frameIndex];
+            if (vkWaitForFences(device, 1, &fence, VK_TRUE, timeout) != VK_SUCCESS)
+            {
+                WARN_LOG("Waiting for fence failed");
+                return false;
+            }
+            return true;
+        }
+
+        //the last submission that used this frame's resources signalled this value on the graphics timeline
+        return WaitForTimelineValue(device, scheduler.graphics.semaphore,
+            scheduler.frameValues[scheduler.frameIndex], timeout);
+    }
+
+    bool SubmitScheduledFrame(VkDevice device,
+        FrameScheduler& scheduler,
+        const std::vector<TimelineWaitInfo>& timelineWaits,
+        const std::vector<WaitSemaphoreInfo>& binaryWaits,
+        const std::vector<VkCommandBuffer>& commandBuffers,
+        const std::vector<VkSemaphore>& binarySignals)
+    {
+        if (!scheduler.timeline)
+        {
+            if (!timelineWaits.empty())
+            {
+                WARN_LOG("Timeline waits are ignored without timeline semaphore support");
+            }
+
+            //the fence is only reset right before it is submitted again, so a skipped frame cannot stall the next wait
+            VkFence fence = scheduler.frameFences[scheduler.frameIndex];
+            ResetFences(device, { fence });
+            SubmitCommandBuffersToQueue(scheduler.graphics.queue, binaryWaits, commandBuffers, binarySignals, fence);
+            return true;
+        }
+
+        uint64_t signalValue;
+        if (!SubmitToQueueTimeline(scheduler.graphics, timelineWaits, binaryWaits, commandBuffers,
+            binarySignals, signalValue))
+        {
+            return false;
+        }
+
+        scheduler.frameValues[scheduler.frameIndex] = signalValue;
+        return true;
+    }
+
+    void EndScheduledFrame(FrameScheduler& scheduler)
+    {
+        scheduler.frameNumber++;
+    }
+
+    //everything submitted so far is covered by the returned value, which is a timeline value or a frame number
+    uint64_t GetFrameSchedulerRetireValue(const FrameScheduler& scheduler)
+    {
+        return scheduler.timeline ? scheduler.graphics.submittedValue : scheduler.frameNumber;
+    }
+
+    bool IsFrameSchedulerValueComplete(VkDevice device,
+        const FrameScheduler& scheduler,
+        uint64_t value)
+    {
+        if (scheduler.timeline)
+        {
+            return GetTimelineValue(device, scheduler.graphics.semaphore) >= value;
+        }
+
+        //without timelines the fence of a frame has been waited on once all other frames in flight have started
+        return scheduler.frameNumber >= value + scheduler.frameValues.size();
+    }
+
+    void DestroyFrameScheduler(VkDevice device,
+        FrameScheduler& scheduler)
+    {
+        if (scheduler.graphics.semaphore != VK_NULL_HANDLE)
+        {
+            DestroySemaphore(device, scheduler.graphics.semaphore);
+        }
+        if (scheduler.compute.semaphore != VK_NULL_HANDLE)
+        {
+            DestroySemaphore(device, scheduler.compute.semaphore);
+        }
+        for (auto& fence : scheduler.frameFences)
+        {
+            DestroyFence(device, fence);
+        }
+
+        scheduler = {};
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "Instance.h"
+#include "PhysicalDevice.h"
+#include "CommandBuffer.h"
+#include "Library/Structs/Semaphore.h"
+
+namespace vk
+{
+    bool CheckTimelineSemaphoreSupport(VkPhysicalDevice physicalDevice,
+        TimelineSemaphoreSupport& support);
+
+    void EnableTimelineSemaphores(TimelineSemaphoreSupport& support,
+        std::vector<const char*>& deviceExtensions,
+        void*& featuresChain);
+
+    void LoadTimelineSemaphoreFunctions(VkDevice device,
+        const TimelineSemaphoreSupport& support);
+
+    bool IsTimelineSemaphoreAvailable();
+
+    void CreateTimelineSemaphore(VkDevice device,
+        uint64_t initialValue,
+        VkSemaphore& semaphore);
+
+    bool WaitForTimelineValue(VkDevice device,
+        VkSemaphore semaphore,
+        uint64_t value,
+        uint64_t timeout);
+
+    uint64_t GetTimelineValue(VkDevice device,
+        VkSemaphore semaphore);
+
+    bool SubmitToQueueTimeline(QueueTimeline& timeline,
+        const std::vector<TimelineWaitInfo>& timelineWaits,
+        const std::vector<WaitSemaphoreInfo>& binaryWaits,
+        const std::vector<VkCommandBuffer>& commandBuffers,
+        const std::vector<VkSemaphore>& binarySignals,
+        uint64_t& signalValue);
+
+    TimelineWaitInfo GetQueueTimelineWait(const QueueTimeline& timeline,
+        VkPipelineStageFlags2 stages);
+
+    void CreateFrameScheduler(VkDevice device,
+        VkQueue graphicsQueue,
+        uint32_t graphicsFamilyIndex,
+        VkQueue computeQueue,
+        uint32_t computeFamilyIndex,
+        uint32_t framesCount,
+        FrameScheduler& scheduler);
+
+    bool WaitForScheduledFrame(VkDevice device,
+        FrameScheduler& scheduler,
+        uint64_t timeout);
+
+    bool SubmitScheduledFrame(VkDevice device,
+        FrameScheduler& scheduler,
+        const std::vector<TimelineWaitInfo>& timelineWaits,
+        const std::vector<WaitSemaphoreInfo>& binaryWaits,
+        const std::vector<VkCommandBuffer>& commandBuffers,
+        const std::vector<VkSemaphore>& binarySignals);
+
+    void EndScheduledFrame(FrameScheduler& scheduler);
+
+    uint64_t GetFrameSchedulerRetireValue(const FrameScheduler& scheduler);
+
+    bool IsFrameSchedulerValueComplete(VkDevice device,
+        const FrameScheduler& scheduler,
+        uint64_t value);
+
+    void DestroyFrameScheduler(VkDevice device,
+        FrameScheduler& scheduler);
+}
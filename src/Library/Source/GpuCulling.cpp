@@ -0,0 +1,518 @@
+#include "GpuCulling.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace vk
+{
+    //the pyramid of a 32768 texel wide depth buffer has 16 levels
+    static const uint32_t maxPyramidLevelsCount = 16;
+
+    static bool CreateCullingComputePipeline(VkDevice device,
+        VkShaderModule shader,
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout& setLayout,
+        VkPipelineLayout& pipelineLayout,
+        VkPipeline& pipeline)
+    {
+        if (shader == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        CreateDescriptorSetLayout(device, bindings, setLayout);
+        CreatePipelineLayout(device, { setLayout }, {}, pipelineLayout);
+
+        std::vector<ShaderStageParams> stageParams =
+        {
+            {
+                VK_SHADER_STAGE_COMPUTE_BIT,
+                shader,
+                "main",
+                nullptr
+            }
+        };
+
+        std::vector<VkPipelineShaderStageCreateInfo> stageInfos;
+        SpecifyPipelineShaderStages(stageParams, stageInfos);
+        CreateComputePipeline(device, 0, stageInfos[0], pipelineLayout, VK_NULL_HANDLE, VK_NULL_HANDLE, pipeline);
+        return true;
+    }
+
+    bool CreateGpuCulling(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkShaderModule cullShader,
+        VkShaderModule pyramidShader,
+        uint32_t maxInstancesCount,
+        uint32_t framesCount,
+        bool indexed,
+        GpuCulling& culling)
+    {
+        culling = {};
+
+        //the written commands pass the instance index as the first instance, vertex shaders read transforms with it
+        if (!GetIndirectDrawSupport().drawIndirectFirstInstance)
+        {
+            WARN_LOG("Gpu culling needs the drawIndirectFirstInstance feature");
+            return false;
+        }
+
+        culling.indexed = indexed;
+        culling.compact = IsDrawIndirectCountAvailable();
+        culling.maxInstancesCount = maxInstancesCount;
+
+        std::vector<VkDescriptorSetLayoutBinding> cullBindings =
+        {
+            { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        };
+        std::vector<VkDescriptorSetLayoutBinding> pyramidBindings =
+        {
+            { 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        };
+
+        if (!CreateCullingComputePipeline(device, cullShader, cullBindings, culling.cullSetLayout,
+                culling.cullPipelineLayout, culling.cullPipeline) ||
+            !CreateCullingComputePipeline(device, pyramidShader, pyramidBindings, culling.pyramidSetLayout,
+                culling.pyramidPipelineLayout, culling.pyramidPipeline))
+        {
+            WARN_LOG("Gpu culling shaders are missing");
+            DestroyGpuCulling(device, culling);
+            return false;
+        }
+
+        //instances are written by the cpu and read by the culling and vertex shaders
+        if (!CreateMappedBuffer(device, gpu, sizeof(CullingInstance) * maxInstancesCount,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, true, culling.instances))
+        {
+            DestroyGpuCulling(device, culling);
+            return false;
+        }
+
+        VkDeviceSize commandSize = indexed ? sizeof(VkDrawIndexedIndirectCommand) : sizeof(VkDrawIndirectCommand);
+        CreateStorageBuffer(device, gpu, commandSize * maxInstancesCount, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            culling.drawCommands, culling.drawCommandsMemory);
+        CreateStorageBuffer(device, gpu, sizeof(uint32_t), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            culling.drawCount, culling.drawCountMemory);
+
+        if (!CreateUniformRing(device, gpu, sizeof(CullingParameters), framesCount, culling.parameters))
+        {
+            DestroyGpuCulling(device, culling);
+            return false;
+        }
+
+        //nearest filtering and clamping keep every sample inside the texels the pyramid reduced
+        CreateSampler(device, VK_FILTER_NEAREST, VK_FILTER_NEAREST, VK_SAMPLER_MIPMAP_MODE_NEAREST,
+            VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            0.0f, false, 1.0f, false, VK_COMPARE_OP_ALWAYS, 0.0f, static_cast<float>(maxPyramidLevelsCount),
+            VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE, false, culling.sampler);
+
+        return true;
+    }
+
+    void SetGpuCullingInstances(VkDevice device,
+        GpuCulling& culling,
+        const std::vector<CullingInstance>& instances)
+    {
+        //the buffer is shared by all frames, so it may only change while none of them is in flight
+        uint32_t count = static_cast<uint32_t>(instances.size());
+        if (count > culling.maxInstancesCount)
+        {
+            WARN_LOG("Gpu culling holds " + std::to_string(culling.maxInstancesCount) + " instances, " +
+                std::to_string(count) + " were given");
+            count = culling.maxInstancesCount;
+        }
+
+        culling.instancesCount = count;
+        if (count > 0)
+        {
+            WriteMappedBuffer(device, culling.instances, 0, instances.data(), sizeof(CullingInstance) * count);
+        }
+    }
+
+    static void DestroyDepthPyramid(VkDevice device,
+        GpuCulling& culling)
+    {
+        DepthPyramid& pyramid = culling.pyramid;
+        for (auto& view : pyramid.levelViews)
+        {
+            DestroyImageView(device, view);
+        }
+        if (pyramid.view != VK_NULL_HANDLE)
+        {
+            DestroyImageView(device, pyramid.view);
+        }
+        if (pyramid.image != VK_NULL_HANDLE)
+        {
+            DestroyImage(device, pyramid.image);
+        }
+        if (pyramid.memory != VK_NULL_HANDLE)
+        {
+            FreeDeviceMemoryObject(device, pyramid.memory);
+        }
+
+        //sets go away with the pool
+        if (culling.descriptorPool != VK_NULL_HANDLE)
+        {
+            DestroyDescriptorPool(device, culling.descriptorPool);
+        }
+        culling.cullSet = VK_NULL_HANDLE;
+        pyramid = {};
+    }
+
+    static void CreatePyramidLevelView(VkDevice device,
+        VkImage image,
+        uint32_t level,
+        VkImageView& view)
+    {
+        VkImageViewCreateInfo viewInfo =
+        {
+            VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            nullptr,
+            0,
+            image,
+            VK_IMAGE_VIEW_TYPE_2D,
+            VK_FORMAT_R32_SFLOAT,
+            {
+                VK_COMPONENT_SWIZZLE_IDENTITY,
+                VK_COMPONENT_SWIZZLE_IDENTITY,
+                VK_COMPONENT_SWIZZLE_IDENTITY,
+                VK_COMPONENT_SWIZZLE_IDENTITY
+            },
+            {
+                VK_IMAGE_ASPECT_COLOR_BIT,
+                level,
+                1,
+                0,
+                1
+            }
+        };
+
+        VK_CHECK_RESULT(vkCreateImageView(device, &viewInfo, nullptr, &view));
+    }
+
+    static uint32_t PreviousPowerOfTwo(uint32_t value)
+    {
+        uint32_t result = 1;
+        while (result * 2 <= value)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+
+    bool ResizeGpuCulling(VkDevice device,
+        VkPhysicalDevice gpu,
+        GpuCulling& culling,
+        VkExtent2D depthSize,
+        const std::vector<VkImageView>& depthViews)
+    {
+        //called with the device idle, the old pyramid and every set pointing at it are rebuilt
+        DestroyDepthPyramid(device, culling);
+        DepthPyramid& pyramid = culling.pyramid;
+
+        //power of two levels halve exactly, only the first reduction covers uneven source texels
+        pyramid.size = { PreviousPowerOfTwo(depthSize.width), PreviousPowerOfTwo(depthSize.height) };
+        uint32_t largest = pyramid.size.width > pyramid.size.height ? pyramid.size.width : pyramid.size.height;
+        pyramid.levelsCount = 1;
+        while ((largest >> pyramid.levelsCount) > 0 && pyramid.levelsCount < maxPyramidLevelsCount)
+        {
+            pyramid.levelsCount++;
+        }
+
+        CreateImage(device, VK_IMAGE_TYPE_2D, VK_FORMAT_R32_SFLOAT, { pyramid.size.width, pyramid.size.height, 1 },
+            pyramid.levelsCount, 1, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            false, pyramid.image);
+        AllocateAndBindMemoryObjectToImage(device, gpu, pyramid.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, pyramid.memory);
+        CreateImageView(device, pyramid.image, VK_IMAGE_VIEW_TYPE_2D, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT,
+            pyramid.view);
+
+        pyramid.levelViews.resize(pyramid.levelsCount);
+        for (uint32_t i = 0; i < pyramid.levelsCount; i++)
+        {
+            CreatePyramidLevelView(device, pyramid.image, i, pyramid.levelViews[i]);
+        }
+
+        //one set per depth buffer writes the first level, one set per remaining level reads the level above it
+        uint32_t pyramidSetsCount = static_cast<uint32_t>(depthViews.size()) + pyramid.levelsCount - 1;
+        std::vector<VkDescriptorPoolSize> poolSizes =
+        {
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3 },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 + pyramidSetsCount },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, pyramidSetsCount },
+        };
+        CreateDescriptorPool(device, false, 1 + pyramidSetsCount, poolSizes, culling.descriptorPool);
+
+        std::vector<VkDescriptorSet> cullSets;
+        AllocateDescriptorSets(device, culling.descriptorPool, { culling.cullSetLayout }, cullSets);
+        culling.cullSet = cullSets[0];
+
+        std::vector<VkDescriptorSetLayout> pyramidLayouts(pyramidSetsCount, culling.pyramidSetLayout);
+        std::vector<VkDescriptorSet> pyramidSets;
+        AllocateDescriptorSets(device, culling.descriptorPool, pyramidLayouts, pyramidSets);
+        pyramid.depthSets.assign(pyramidSets.begin(), pyramidSets.begin() + depthViews.size());
+        pyramid.levelSets.assign(pyramidSets.begin() + depthViews.size(), pyramidSets.end());
+
+        VkDeviceSize commandSize = culling.indexed ? sizeof(VkDrawIndexedIndirectCommand) : sizeof(VkDrawIndirectCommand);
+        std::vector<BufferDescriptorInfo> bufferInfos =
+        {
+            { culling.cullSet, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                { { culling.parameters.storage.buffer, 0, sizeof(CullingParameters) } } },
+            { culling.cullSet, 1, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                { { culling.instances.buffer, 0, sizeof(CullingInstance) * culling.maxInstancesCount } } },
+            { culling.cullSet, 2, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                { { culling.drawCommands, 0, commandSize * culling.maxInstancesCount } } },
+            { culling.cullSet, 3, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                { { culling.drawCount, 0, sizeof(uint32_t) } } },
+        };
+
+        std::vector<ImageDescriptorInfo> imageInfos =
+        {
+            { culling.cullSet, 4, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                { { culling.sampler, pyramid.view, VK_IMAGE_LAYOUT_GENERAL } } },
+        };
+
+        for (size_t i = 0; i < depthViews.size(); i++)
+        {
+            imageInfos.push_back({ pyramid.depthSets[i], 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                { { culling.sampler, depthViews[i], VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL } } });
+            imageInfos.push_back({ pyramid.depthSets[i], 1, 0, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                { { VK_NULL_HANDLE, pyramid.levelViews[0], VK_IMAGE_LAYOUT_GENERAL } } });
+        }
+
+        for (uint32_t level = 1; level < pyramid.levelsCount; level++)
+        {
+            imageInfos.push_back({ pyramid.levelSets[level - 1], 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                { { culling.sampler, pyramid.levelViews[level - 1], VK_IMAGE_LAYOUT_GENERAL } } });
+            imageInfos.push_back({ pyramid.levelSets[level - 1], 1, 0, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                { { VK_NULL_HANDLE, pyramid.levelViews[level], VK_IMAGE_LAYOUT_GENERAL } } });
+        }
+
+        UpdateDescriptorSets(device, imageInfos, bufferInfos, {}, {});
+        return true;
+    }
+
+    //planes of a depth range from 0 to 1, the matrix is column major as glm stores it
+    static void ExtractFrustumPlanes(const float viewProjection[16],
+        float planes[6][4])
+    {
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            float row0 = viewProjection[i * 4 + 0];
+            float row1 = viewProjection[i * 4 + 1];
+            float row2 = viewProjection[i * 4 + 2];
+            float row3 = viewProjection[i * 4 + 3];
+
+            planes[0][i] = row3 + row0;
+            planes[1][i] = row3 - row0;
+            planes[2][i] = row3 + row1;
+            planes[3][i] = row3 - row1;
+            planes[4][i] = row2;
+            planes[5][i] = row3 - row2;
+        }
+
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            float length = std::sqrt(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] + planes[i][2] * planes[i][2]);
+            if (length > 0.0f)
+            {
+                for (auto& value : planes[i])
+                {
+                    value /= length;
+                }
+            }
+        }
+    }
+
+    bool RecordGpuCulling(VkDevice device,
+        VkCommandBuffer commandBuffer,
+        GpuCulling& culling,
+        uint32_t frameIndex,
+        const float viewProjection[16])
+    {
+        //recorded once per frame outside of a render pass, before the draws that consume the commands
+        CullingParameters parameters = {};
+        std::copy(viewProjection, viewProjection + 16, parameters.viewProjection);
+        std::copy(culling.pyramid.viewProjection, culling.pyramid.viewProjection + 16, parameters.pyramidViewProjection);
+        ExtractFrustumPlanes(viewProjection, parameters.frustumPlanes);
+        parameters.pyramidSize[0] = static_cast<float>(culling.pyramid.size.width);
+        parameters.pyramidSize[1] = static_cast<float>(culling.pyramid.size.height);
+        parameters.instancesCount = culling.instancesCount;
+        parameters.flags = (culling.indexed ? CULLING_INDEXED : 0) | (culling.compact ? CULLING_COMPACT : 0) |
+            (culling.pyramid.built ? CULLING_OCCLUSION : 0);
+
+        BeginUniformRingFrame(culling.parameters, frameIndex);
+        uint32_t parametersOffset;
+        if (!PushUniformData(culling.parameters, &parameters, sizeof(parameters), parametersOffset))
+        {
+            return false;
+        }
+        FlushUniformRingFrame(device, culling.parameters);
+
+        //the depth drawn after this pass is seen through this matrix, the pyramid built from it takes it over
+        std::copy(viewProjection, viewProjection + 16, culling.viewProjection);
+
+        //the previous frame's draws still read the commands and its pyramid reduction has to be visible
+        BarrierBatch batch;
+        BeginBarrierBatch(commandBuffer, batch);
+        AddMemoryBarrierToBatch(batch, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+        FlushBarrierBatch(batch);
+
+        if (culling.compact)
+        {
+            vkCmdFillBuffer(commandBuffer, culling.drawCount, 0, sizeof(uint32_t), 0);
+            AddBufferBarrierToBatch(batch, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                { culling.drawCount, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED });
+            FlushBarrierBatch(batch);
+        }
+
+        //before the first reduction the pyramid holds nothing, so only the frustum test runs
+        if (!culling.pyramid.initialized)
+        {
+            AddImageBarrierToBatch(batch, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                { culling.pyramid.image, 0, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, VK_IMAGE_ASPECT_COLOR_BIT });
+            FlushBarrierBatch(batch);
+            culling.pyramid.initialized = true;
+        }
+
+        BindPipelineObject(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling.cullPipeline);
+        BindDescitorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling.cullPipelineLayout, 0,
+            { culling.cullSet }, { parametersOffset });
+        DispatchComputeWork(commandBuffer, (culling.instancesCount + 63) / 64, 1, 1);
+
+        AddMemoryBarrierToBatch(batch, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+        FlushBarrierBatch(batch);
+        return true;
+    }
+
+    void DrawGpuCulledGeometry(VkCommandBuffer commandBuffer,
+        const GpuCulling& culling)
+    {
+        //without a gpu written count every slot is drawn and culled instances draw zero instances
+        if (culling.compact && culling.indexed)
+        {
+            DrawIndexedGeometryIndirectCount(commandBuffer, culling.drawCommands, 0, culling.drawCount, 0,
+                culling.instancesCount);
+        }
+        else if (culling.compact)
+        {
+            DrawGeometryIndirectCount(commandBuffer, culling.drawCommands, 0, culling.drawCount, 0,
+                culling.instancesCount);
+        }
+        else if (culling.indexed)
+        {
+            DrawIndexedGeometryIndirect(commandBuffer, culling.drawCommands, 0, culling.instancesCount);
+        }
+        else
+        {
+            DrawGeometryIndirect(commandBuffer, culling.drawCommands, 0, culling.instancesCount);
+        }
+    }
+
+    void RecordDepthPyramid(VkCommandBuffer commandBuffer,
+        GpuCulling& culling,
+        VkImage depthImage,
+        uint32_t depthIndex,
+        VkImageLayout depthLayout)
+    {
+        //recorded after the render pass, the depth needs sampled usage and a stored attachment, and it is left
+        //read only for the next render pass that clears it anyway
+        DepthPyramid& pyramid = culling.pyramid;
+
+        BarrierBatch batch;
+        BeginBarrierBatch(commandBuffer, batch);
+        AddImageBarrierToBatch(batch, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            { depthImage, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, depthLayout,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+            VK_IMAGE_ASPECT_DEPTH_BIT });
+
+        //the culling pass of this frame reads the levels that are about to be overwritten
+        if (pyramid.initialized)
+        {
+            AddMemoryBarrierToBatch(batch, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0, VK_ACCESS_SHADER_WRITE_BIT);
+        }
+        else
+        {
+            AddImageBarrierToBatch(batch, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                { pyramid.image, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, VK_IMAGE_ASPECT_COLOR_BIT });
+            pyramid.initialized = true;
+        }
+        FlushBarrierBatch(batch);
+
+        BindPipelineObject(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling.pyramidPipeline);
+        for (uint32_t level = 0; level < pyramid.levelsCount; level++)
+        {
+            VkDescriptorSet set = level == 0 ? pyramid.depthSets[depthIndex] : pyramid.levelSets[level - 1];
+            BindDescitorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling.pyramidPipelineLayout, 0, { set }, {});
+
+            uint32_t width = pyramid.size.width >> level;
+            uint32_t height = pyramid.size.height >> level;
+            DispatchComputeWork(commandBuffer, ((width > 0 ? width : 1) + 7) / 8, ((height > 0 ? height : 1) + 7) / 8, 1);
+
+            //each level is the source of the next one, the last barrier also covers the next frame's culling
+            AddMemoryBarrierToBatch(batch, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+            FlushBarrierBatch(batch);
+        }
+
+        std::copy(culling.viewProjection, culling.viewProjection + 16, pyramid.viewProjection);
+        pyramid.built = true;
+    }
+
+    void DestroyGpuCulling(VkDevice device,
+        GpuCulling& culling)
+    {
+        DestroyDepthPyramid(device, culling);
+
+        if (culling.sampler != VK_NULL_HANDLE)
+        {
+            DestroySampler(device, culling.sampler);
+        }
+        if (culling.parameters.storage.buffer != VK_NULL_HANDLE)
+        {
+            DestroyUniformRing(device, culling.parameters);
+        }
+        if (culling.drawCount != VK_NULL_HANDLE)
+        {
+            DestroyBuffer(device, culling.drawCount);
+            FreeDeviceMemoryObject(device, culling.drawCountMemory);
+        }
+        if (culling.drawCommands != VK_NULL_HANDLE)
+        {
+            DestroyBuffer(device, culling.drawCommands);
+            FreeDeviceMemoryObject(device, culling.drawCommandsMemory);
+        }
+        if (culling.instances.buffer != VK_NULL_HANDLE)
+        {
+            DestroyMappedBuffer(device, culling.instances);
+        }
+
+        if (culling.cullPipeline != VK_NULL_HANDLE)
+        {
+            DestroyPipeline(device, culling.cullPipeline);
+            DestroyPipelineLayout(device, culling.cullPipelineLayout);
+            DestroyDescriptorSetLayout(device, culling.cullSetLayout);
+        }
+        if (culling.pyramidPipeline != VK_NULL_HANDLE)
+        {
+            DestroyPipeline(device, culling.pyramidPipeline);
+            DestroyPipelineLayout(device, culling.pyramidPipelineLayout);
+            DestroyDescriptorSetLayout(device, culling.pyramidSetLayout);
+        }
+
+        culling = {};
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "Resources.h"
+#include "DescriptorSets.h"
+#include "Pipeline.h"
+#include "Drawing.h"
+#include "MappedBuffer.h"
+#include "UniformRing.h"
+#include "BarrierBatch.h"
+#include "IndirectDraw.h"
+#include "Library/Structs/Culling.h"
+
+namespace vk
+{
+    bool CreateGpuCulling(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkShaderModule cullShader,
+        VkShaderModule pyramidShader,
+        uint32_t maxInstancesCount,
+        uint32_t framesCount,
+        bool indexed,
+        GpuCulling& culling);
+
+    void SetGpuCullingInstances(VkDevice device,
+        GpuCulling& culling,
+        const std::vector<CullingInstance>& instances);
+
+    bool ResizeGpuCulling(VkDevice device,
+        VkPhysicalDevice gpu,
+        GpuCulling& culling,
+        VkExtent2D depthSize,
+        const std::vector<VkImageView>& depthViews);
+
+    bool RecordGpuCulling(VkDevice device,
+        VkCommandBuffer commandBuffer,
+        GpuCulling& culling,
+        uint32_t frameIndex,
+        const float viewProjection[16]);
+
+    void DrawGpuCulledGeometry(VkCommandBuffer commandBuffer,
+        const GpuCulling& culling);
+
+    void RecordDepthPyramid(VkCommandBuffer commandBuffer,
+        GpuCulling& culling,
+        VkImage depthImage,
+        uint32_t depthIndex,
+        VkImageLayout depthLayout);
+
+    void DestroyGpuCulling(VkDevice device,
+        GpuCulling& culling);
+}
@@ -0,0 +1,90 @@
+#include "IndirectDraw.h"
+
+namespace vk
+{
+    //the framework drives a single device, so the enabled features and entry points are kept here
+    static IndirectDrawSupport indirectDrawSupport = {};
+    static IndirectDrawFunctions indirectDrawFunctions = {};
+
+    bool CheckIndirectDrawSupport(VkPhysicalDevice physicalDevice,
+        IndirectDrawSupport& support)
+    {
+        support = {};
+
+        VkPhysicalDeviceFeatures features;
+        VkPhysicalDeviceProperties properties;
+        GetFeaturesAndPropertiesOfPhysicalDevice(physicalDevice, features, properties);
+
+        support.multiDrawIndirect = features.multiDrawIndirect == VK_TRUE;
+        support.drawIndirectFirstInstance = features.drawIndirectFirstInstance == VK_TRUE;
+        support.maxDrawIndirectCount = support.multiDrawIndirect ? properties.limits.maxDrawIndirectCount : 1;
+
+        //the count variants are core in 1.2 only behind a feature of the 1.2 feature structure, which cannot be
+        //chained together with the separate descriptor indexing and timeline structures, so the extension is used
+        std::vector<VkExtensionProperties> availableExtensions;
+        if (CheckAvailableDeviceExtensions(physicalDevice, availableExtensions))
+        {
+            support.drawIndirectCount = IsExtensionSupported(availableExtensions, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+        }
+
+        return support.multiDrawIndirect;
+    }
+
+    void EnableIndirectDraw(const IndirectDrawSupport& support,
+        std::vector<const char*>& deviceExtensions,
+        VkPhysicalDeviceFeatures& deviceFeatures)
+    {
+        if (support.multiDrawIndirect)
+        {
+            deviceFeatures.multiDrawIndirect = VK_TRUE;
+        }
+
+        if (support.drawIndirectFirstInstance)
+        {
+            deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+        }
+
+        if (support.drawIndirectCount)
+        {
+            deviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+        }
+    }
+
+    void LoadIndirectDrawFunctions(VkDevice device,
+        const IndirectDrawSupport& support)
+    {
+        indirectDrawSupport = support;
+        indirectDrawFunctions = {};
+
+        if (support.drawIndirectCount)
+        {
+            indirectDrawFunctions.cmdDrawIndirectCount = (PFN_vkCmdDrawIndirectCountKHR)vkGetDeviceProcAddr(device,
+                "vkCmdDrawIndirectCountKHR");
+            indirectDrawFunctions.cmdDrawIndexedIndirectCount = (PFN_vkCmdDrawIndexedIndirectCountKHR)vkGetDeviceProcAddr(device,
+                "vkCmdDrawIndexedIndirectCountKHR");
+
+            if (indirectDrawFunctions.cmdDrawIndirectCount == nullptr ||
+                indirectDrawFunctions.cmdDrawIndexedIndirectCount == nullptr)
+            {
+                WARN_LOG("Could not load draw indirect count functions");
+                indirectDrawFunctions = {};
+                indirectDrawSupport.drawIndirectCount = false;
+            }
+        }
+    }
+
+    const IndirectDrawSupport& GetIndirectDrawSupport()
+    {
+        return indirectDrawSupport;
+    }
+
+    const IndirectDrawFunctions& GetIndirectDrawFunctions()
+    {
+        return indirectDrawFunctions;
+    }
+
+    bool IsDrawIndirectCountAvailable()
+    {
+        return indirectDrawSupport.drawIndirectCount;
+    }
+}
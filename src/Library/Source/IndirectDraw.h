@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "Instance.h"
+#include "PhysicalDevice.h"
+#include "Library/Structs/IndirectDraw.h"
+
+namespace vk
+{
+    bool CheckIndirectDrawSupport(VkPhysicalDevice physicalDevice,
+        IndirectDrawSupport& support);
+
+    void EnableIndirectDraw(const IndirectDrawSupport& support,
+        std::vector<const char*>& deviceExtensions,
+        VkPhysicalDeviceFeatures& deviceFeatures);
+
+    void LoadIndirectDrawFunctions(VkDevice device,
+        const IndirectDrawSupport& support);
+
+    const IndirectDrawSupport& GetIndirectDrawSupport();
+
+    const IndirectDrawFunctions& GetIndirectDrawFunctions();
+
+    bool IsDrawIndirectCountAvailable();
+}
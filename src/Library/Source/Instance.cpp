@@ -40,6 +40,20 @@ namespace vk
         return false;
     }
 
+    uint32_t GetSupportedInstanceVersion()
+    {
+        //vkEnumerateInstanceVersion is missing from 1.0 loaders
+        auto enumerateInstanceVersion = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceVersion");
+        if (enumerateInstanceVersion == nullptr)
+        {
+            return VK_API_VERSION_1_0;
+        }
+
+        uint32_t version = VK_API_VERSION_1_0;
+        VK_CHECK_RESULT(enumerateInstanceVersion(&version));
+        return version < VK_API_VERSION_1_3 ? version : VK_API_VERSION_1_3;
+    }
+
     bool CreateVulkanInstance(std::vector<const char*>& desiredExtensions,
         std::vector<const char*> desiredValidationLayers,
         bool isDebugModeEnabled,
@@ -68,7 +82,7 @@ namespace vk
         appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
         appInfo.pEngineName = "VulkanEngine";
         appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-        appInfo.apiVersion = VK_API_VERSION_1_0;
+        appInfo.apiVersion = GetSupportedInstanceVersion();
 
         VkInstanceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -10,6 +10,8 @@ namespace vk
     bool IsExtensionSupported(std::vector<VkExtensionProperties>& availableExtensions, 
         const char* extension);
 
+    uint32_t GetSupportedInstanceVersion();
+
     bool CreateVulkanInstance(std::vector<const char*>& desiredExtensions,
         std::vector<const char*> desiredValidationLayers,
         bool isDebugModeEnabled,
@@ -0,0 +1,69 @@
+#include "LinearAllocator.h"
+
+namespace vk
+{
+    bool CreateLinearAllocator(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkDeviceSize frameSize,
+        uint32_t framesCount,
+        VkBufferUsageFlags usage,
+        LinearAllocator& allocator)
+    {
+        allocator.frameSize = frameSize;
+        allocator.framesCount = framesCount;
+        allocator.frameIndex = 0;
+        allocator.frameOffset = 0;
+
+        return CreateMappedBuffer(device, gpu, frameSize * framesCount, usage, true, allocator.storage);
+    }
+
+    void BeginLinearAllocatorFrame(LinearAllocator& allocator,
+        uint32_t frameIndex)
+    {
+        //call after the scheduler waited for this frame, the whole region is released at once
+        allocator.frameIndex = frameIndex % allocator.framesCount;
+        allocator.frameOffset.store(0, std::memory_order_relaxed);
+    }
+
+    bool AllocateFromLinearAllocator(LinearAllocator& allocator,
+        VkDeviceSize size,
+        VkDeviceSize alignment,
+        LinearAllocation& allocation)
+    {
+        //recording threads only race on the offset, so a compare and swap is enough
+        VkDeviceSize current = allocator.frameOffset.load(std::memory_order_relaxed);
+        VkDeviceSize aligned;
+        do
+        {
+            aligned = alignment > 1 ? (current + alignment - 1) / alignment * alignment : current;
+            if (aligned + size > allocator.frameSize)
+            {
+                WARN_LOG("Linear allocator frame region is full");
+                return false;
+            }
+        } while (!allocator.frameOffset.compare_exchange_weak(current, aligned + size, std::memory_order_relaxed));
+
+        VkDeviceSize offset = allocator.frameIndex * allocator.frameSize + aligned;
+        allocation =
+        {
+            allocator.storage.mappedData + offset,
+            allocator.storage.buffer,
+            offset
+        };
+        return true;
+    }
+
+    void FlushLinearAllocatorFrame(VkDevice device,
+        const LinearAllocator& allocator)
+    {
+        //called once recording threads are done, before the frame is submitted
+        FlushMappedBuffer(device, allocator.storage, allocator.frameIndex * allocator.frameSize,
+            allocator.frameOffset.load(std::memory_order_relaxed));
+    }
+
+    void DestroyLinearAllocator(VkDevice device,
+        LinearAllocator& allocator)
+    {
+        DestroyMappedBuffer(device, allocator.storage);
+    }
+}
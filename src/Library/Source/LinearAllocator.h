@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "MappedBuffer.h"
+#include "Library/Structs/Buffer.h"
+
+namespace vk
+{
+    bool CreateLinearAllocator(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkDeviceSize frameSize,
+        uint32_t framesCount,
+        VkBufferUsageFlags usage,
+        LinearAllocator& allocator);
+
+    void BeginLinearAllocatorFrame(LinearAllocator& allocator,
+        uint32_t frameIndex);
+
+    bool AllocateFromLinearAllocator(LinearAllocator& allocator,
+        VkDeviceSize size,
+        VkDeviceSize alignment,
+        LinearAllocation& allocation);
+
+    void FlushLinearAllocatorFrame(VkDevice device,
+        const LinearAllocator& allocator);
+
+    void DestroyLinearAllocator(VkDevice device,
+        LinearAllocator& allocator);
+}
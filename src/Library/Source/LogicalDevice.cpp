@@ -7,6 +7,7 @@ namespace vk
         std::vector<const char*> validationLayers,
         std::vector<QueueInfo> queuesInfo,
         VkPhysicalDeviceFeatures* desiredFeatures,
+        void* featuresChain,
         bool isDebugModeEnabled,
         VkDevice& logicalDevice)
     {
@@ -42,7 +43,7 @@ namespace vk
         VkDeviceCreateInfo deviceInfo =
         {
             VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-            nullptr,
+            featuresChain,
             0,
             static_cast<uint32_t>(queueCreateInfos.size()),
             queueCreateInfos.data(),
@@ -117,7 +118,7 @@ namespace vk
             }
 
             if (CreateLogicalDevice(gpu, desiredExtensions, validationLayers, requestedQueues, &features,
-                isDebugModeEnabled, logicalDevice))
+                nullptr, isDebugModeEnabled, logicalDevice))
             {
                 continue;
             }
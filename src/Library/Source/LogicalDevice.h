@@ -12,6 +12,7 @@ namespace vk
         std::vector<const char*> validationLayers,
         std::vector<QueueInfo> queuesInfo,
         VkPhysicalDeviceFeatures* desiredFeatures,
+        void* featuresChain,
         bool isDebugModeEnabled,
         VkDevice& logicalDevice);
 
@@ -0,0 +1,95 @@
+#include "MappedBuffer.h"
+
+#include <cstring>
+
+namespace vk
+{
+    bool CreateMappedBuffer(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        bool preferDeviceLocal,
+        MappedBuffer& mappedBuffer)
+    {
+        VkPhysicalDeviceFeatures features;
+        VkPhysicalDeviceProperties properties;
+        GetFeaturesAndPropertiesOfPhysicalDevice(gpu, features, properties);
+
+        mappedBuffer.size = size;
+        mappedBuffer.nonCoherentAtomSize = properties.limits.nonCoherentAtomSize;
+        mappedBuffer.mappedData = nullptr;
+
+        CreateBuffer(device, size, usage, mappedBuffer.buffer);
+        mappedBuffer.memoryProperties = AllocateAndBindHostVisibleMemoryToBuffer(device, gpu, mappedBuffer.buffer,
+            preferDeviceLocal, mappedBuffer.memory);
+        if (mappedBuffer.memoryProperties == 0)
+        {
+            return false;
+        }
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetBufferMemoryRequirements(device, mappedBuffer.buffer, &memoryRequirements);
+        mappedBuffer.memorySize = memoryRequirements.size;
+
+        //the memory stays mapped until the buffer is destroyed
+        void* mappedData;
+        VK_CHECK_RESULT(vkMapMemory(device, mappedBuffer.memory, 0, VK_WHOLE_SIZE, 0, &mappedData));
+        mappedBuffer.mappedData = static_cast<unsigned char*>(mappedData);
+        return mappedBuffer.mappedData != nullptr;
+    }
+
+    bool IsMappedBufferCoherent(const MappedBuffer& mappedBuffer)
+    {
+        return (mappedBuffer.memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+    }
+
+    void FlushMappedBuffer(VkDevice device,
+        const MappedBuffer& mappedBuffer,
+        VkDeviceSize offset,
+        VkDeviceSize size)
+    {
+        if (IsMappedBufferCoherent(mappedBuffer) || size == 0)
+        {
+            return;
+        }
+
+        //non coherent ranges must start and end on multiples of the atom size, or end with the allocation
+        VkDeviceSize atom = mappedBuffer.nonCoherentAtomSize;
+        VkDeviceSize begin = offset / atom * atom;
+        VkDeviceSize end = (offset + size + atom - 1) / atom * atom;
+
+        VkMappedMemoryRange range =
+        {
+            VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+            nullptr,
+            mappedBuffer.memory,
+            begin,
+            end >= mappedBuffer.memorySize ? VK_WHOLE_SIZE : end - begin
+        };
+
+        VK_CHECK_RESULT(vkFlushMappedMemoryRanges(device, 1, &range));
+    }
+
+    void WriteMappedBuffer(VkDevice device,
+        const MappedBuffer& mappedBuffer,
+        VkDeviceSize offset,
+        const void* data,
+        VkDeviceSize size)
+    {
+        std::memcpy(mappedBuffer.mappedData + offset, data, static_cast<size_t>(size));
+        FlushMappedBuffer(device, mappedBuffer, offset, size);
+    }
+
+    void DestroyMappedBuffer(VkDevice device,
+        MappedBuffer& mappedBuffer)
+    {
+        if (mappedBuffer.mappedData != nullptr)
+        {
+            vkUnmapMemory(device, mappedBuffer.memory);
+            mappedBuffer.mappedData = nullptr;
+        }
+
+        DestroyBuffer(device, mappedBuffer.buffer);
+        FreeDeviceMemoryObject(device, mappedBuffer.memory);
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "PhysicalDevice.h"
+#include "Resources.h"
+#include "Library/Structs/Buffer.h"
+
+namespace vk
+{
+    bool CreateMappedBuffer(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        bool preferDeviceLocal,
+        MappedBuffer& mappedBuffer);
+
+    bool IsMappedBufferCoherent(const MappedBuffer& mappedBuffer);
+
+    void FlushMappedBuffer(VkDevice device,
+        const MappedBuffer& mappedBuffer,
+        VkDeviceSize offset,
+        VkDeviceSize size);
+
+    void WriteMappedBuffer(VkDevice device,
+        const MappedBuffer& mappedBuffer,
+        VkDeviceSize offset,
+        const void* data,
+        VkDeviceSize size);
+
+    void DestroyMappedBuffer(VkDevice device,
+        MappedBuffer& mappedBuffer);
+}
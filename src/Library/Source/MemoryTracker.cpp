@@ -0,0 +1,317 @@
+#include "MemoryTracker.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace vk
+{
+    //the framework drives a single device, so its allocations are tracked here
+    static std::mutex trackerMutex;
+    static VkPhysicalDevice trackedGpu = VK_NULL_HANDLE;
+    static bool budgetEnabled = false;
+    static VkPhysicalDeviceMemoryProperties memoryProperties = {};
+    static std::unordered_map<VkBuffer, MemoryCategory> bufferCategories;
+    static std::unordered_map<VkImage, MemoryCategory> imageCategories;
+    static std::unordered_map<VkDeviceMemory, TrackedAllocation> allocations;
+    static VkDeviceSize typeUsage[VK_MAX_MEMORY_TYPES] = {};
+    static uint32_t typeAllocationsCount[VK_MAX_MEMORY_TYPES] = {};
+    static VkDeviceSize categoryUsage[MEMORY_CATEGORY_COUNT] = {};
+    static bool heapWarned[VK_MAX_MEMORY_HEAPS] = {};
+
+    //without the budget extension a heap is considered full well before its size,
+    //the os and other applications share it
+    static const double budgetWarningRatio = 0.9;
+    static const double heapWarningRatio = 0.8;
+
+    static std::string FormatMegabytes(VkDeviceSize size)
+    {
+        return std::to_string(size / (1024 * 1024)) + " MB";
+    }
+
+    static void QueryHeapBudgets(VkDeviceSize budgets[VK_MAX_MEMORY_HEAPS],
+        VkDeviceSize usages[VK_MAX_MEMORY_HEAPS])
+    {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties =
+        {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT
+        };
+
+        VkPhysicalDeviceMemoryProperties2 properties =
+        {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+            &budgetProperties
+        };
+
+        vkGetPhysicalDeviceMemoryProperties2(trackedGpu, &properties);
+        for (uint32_t i = 0; i < VK_MAX_MEMORY_HEAPS; i++)
+        {
+            budgets[i] = budgetProperties.heapBudget[i];
+            usages[i] = budgetProperties.heapUsage[i];
+        }
+    }
+
+    static VkDeviceSize GetTrackedHeapUsage(uint32_t heapIndex)
+    {
+        VkDeviceSize usage = 0;
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+        {
+            if (memoryProperties.memoryTypes[i].heapIndex == heapIndex)
+            {
+                usage += typeUsage[i];
+            }
+        }
+        return usage;
+    }
+
+    static void CheckHeapCommitment(uint32_t heapIndex)
+    {
+        VkDeviceSize usage = GetTrackedHeapUsage(heapIndex);
+        VkDeviceSize limit = static_cast<VkDeviceSize>(memoryProperties.memoryHeaps[heapIndex].size * heapWarningRatio);
+        if (budgetEnabled)
+        {
+            VkDeviceSize budgets[VK_MAX_MEMORY_HEAPS];
+            VkDeviceSize usages[VK_MAX_MEMORY_HEAPS];
+            QueryHeapBudgets(budgets, usages);
+            usage = usages[heapIndex];
+            limit = static_cast<VkDeviceSize>(budgets[heapIndex] * budgetWarningRatio);
+        }
+
+        //warn once when the threshold is crossed, again only after usage dropped below it
+        if (usage <= limit)
+        {
+            heapWarned[heapIndex] = false;
+            return;
+        }
+
+        if (!heapWarned[heapIndex])
+        {
+            heapWarned[heapIndex] = true;
+            WARN_LOG("Memory heap " + std::to_string(heapIndex) + " is close to over-commitment: " +
+                FormatMegabytes(usage) + " used, warning limit " + FormatMegabytes(limit));
+        }
+    }
+
+    static void TrackMemoryAllocation(VkDeviceMemory memoryObject,
+        uint32_t memoryTypeIndex,
+        VkDeviceSize size,
+        MemoryCategory category)
+    {
+        allocations[memoryObject] = { size, memoryTypeIndex, category };
+        typeUsage[memoryTypeIndex] += size;
+        typeAllocationsCount[memoryTypeIndex]++;
+        categoryUsage[category] += size;
+
+        if (memoryTypeIndex < memoryProperties.memoryTypeCount)
+        {
+            CheckHeapCommitment(memoryProperties.memoryTypes[memoryTypeIndex].heapIndex);
+        }
+    }
+
+    bool CheckMemoryBudgetSupport(VkPhysicalDevice physicalDevice)
+    {
+        std::vector<VkExtensionProperties> availableExtensions;
+        if (!CheckAvailableDeviceExtensions(physicalDevice, availableExtensions))
+        {
+            return false;
+        }
+
+        return IsExtensionSupported(availableExtensions, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
+    void InitializeMemoryTracker(VkPhysicalDevice physicalDevice,
+        bool memoryBudgetEnabled)
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        trackedGpu = physicalDevice;
+        budgetEnabled = memoryBudgetEnabled;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+    }
+
+    void RegisterBufferMemoryCategory(VkBuffer buffer,
+        VkBufferUsageFlags usage)
+    {
+        MemoryCategory category = MEMORY_CATEGORY_OTHER;
+        if (usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+        {
+            category = MEMORY_CATEGORY_VERTEX;
+        }
+        else if (usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+        {
+            category = MEMORY_CATEGORY_INDEX;
+        }
+        else if (usage & (VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT))
+        {
+            category = MEMORY_CATEGORY_UNIFORM;
+        }
+        else if (usage & (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT |
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT))
+        {
+            category = MEMORY_CATEGORY_STORAGE;
+        }
+        else if (usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+        {
+            category = MEMORY_CATEGORY_STAGING;
+        }
+
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        bufferCategories[buffer] = category;
+    }
+
+    void RegisterImageMemoryCategory(VkImage image,
+        VkImageUsageFlags usage)
+    {
+        VkImageUsageFlags attachmentUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        imageCategories[image] = (usage & attachmentUsage) ? MEMORY_CATEGORY_ATTACHMENT : MEMORY_CATEGORY_TEXTURE;
+    }
+
+    void UnregisterBufferMemoryCategory(VkBuffer buffer)
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        bufferCategories.erase(buffer);
+    }
+
+    void UnregisterImageMemoryCategory(VkImage image)
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        imageCategories.erase(image);
+    }
+
+    void TrackBufferMemoryAllocation(VkBuffer buffer,
+        VkDeviceMemory memoryObject,
+        uint32_t memoryTypeIndex,
+        VkDeviceSize size)
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        auto category = bufferCategories.find(buffer);
+        TrackMemoryAllocation(memoryObject, memoryTypeIndex, size,
+            category != bufferCategories.end() ? category->second : MEMORY_CATEGORY_OTHER);
+    }
+
+    void TrackImageMemoryAllocation(VkImage image,
+        VkDeviceMemory memoryObject,
+        uint32_t memoryTypeIndex,
+        VkDeviceSize size)
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        auto category = imageCategories.find(image);
+        TrackMemoryAllocation(memoryObject, memoryTypeIndex, size,
+            category != imageCategories.end() ? category->second : MEMORY_CATEGORY_TEXTURE);
+    }
+
+    void UntrackMemoryAllocation(VkDeviceMemory memoryObject)
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        auto allocation = allocations.find(memoryObject);
+        if (allocation == allocations.end())
+        {
+            return;
+        }
+
+        typeUsage[allocation->second.memoryTypeIndex] -= allocation->second.size;
+        typeAllocationsCount[allocation->second.memoryTypeIndex]--;
+        categoryUsage[allocation->second.category] -= allocation->second.size;
+        allocations.erase(allocation);
+    }
+
+    void GetMemoryStats(MemoryStats& stats)
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        stats.budgetAvailable = budgetEnabled;
+        stats.heaps.clear();
+        stats.types.clear();
+
+        VkDeviceSize budgets[VK_MAX_MEMORY_HEAPS] = {};
+        VkDeviceSize usages[VK_MAX_MEMORY_HEAPS] = {};
+        if (budgetEnabled)
+        {
+            QueryHeapBudgets(budgets, usages);
+        }
+
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+        {
+            stats.heaps.push_back(
+                {
+                    memoryProperties.memoryHeaps[i].flags,
+                    memoryProperties.memoryHeaps[i].size,
+                    GetTrackedHeapUsage(i),
+                    budgetEnabled ? budgets[i] : memoryProperties.memoryHeaps[i].size,
+                    budgetEnabled ? usages[i] : GetTrackedHeapUsage(i)
+                });
+        }
+
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+        {
+            stats.types.push_back(
+                {
+                    memoryProperties.memoryTypes[i].propertyFlags,
+                    memoryProperties.memoryTypes[i].heapIndex,
+                    typeUsage[i],
+                    typeAllocationsCount[i]
+                });
+        }
+
+        for (uint32_t i = 0; i < MEMORY_CATEGORY_COUNT; i++)
+        {
+            stats.categoryUsage[i] = categoryUsage[i];
+        }
+    }
+
+    void LogMemoryStats()
+    {
+        MemoryStats stats;
+        GetMemoryStats(stats);
+
+        for (size_t i = 0; i < stats.heaps.size(); i++)
+        {
+            const MemoryHeapStats& heap = stats.heaps[i];
+            std::string kind = (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? "device local" : "host";
+            INFO_LOG("Heap " + std::to_string(i) + " (" + kind + ", " + FormatMegabytes(heap.size) + "): tracked " +
+                FormatMegabytes(heap.trackedUsage) + ", usage " + FormatMegabytes(heap.usage) + " of budget " +
+                FormatMegabytes(heap.budget) + (stats.budgetAvailable ? "" : " (no budget extension)"));
+        }
+
+        for (size_t i = 0; i < stats.types.size(); i++)
+        {
+            const MemoryTypeStats& type = stats.types[i];
+            if (type.allocationsCount == 0)
+            {
+                continue;
+            }
+
+            INFO_LOG("Memory type " + std::to_string(i) + " on heap " + std::to_string(type.heapIndex) + ": " +
+                std::to_string(type.allocationsCount) + " allocations, " + FormatMegabytes(type.trackedUsage));
+        }
+
+        for (uint32_t i = 0; i < MEMORY_CATEGORY_COUNT; i++)
+        {
+            std::string name = GetMemoryCategoryName(static_cast<MemoryCategory>(i));
+            INFO_LOG(name + ": " + FormatMegabytes(stats.categoryUsage[i]));
+        }
+    }
+
+    const char* GetMemoryCategoryName(MemoryCategory category)
+    {
+        switch (category)
+        {
+        case MEMORY_CATEGORY_VERTEX:
+            return "vertex";
+        case MEMORY_CATEGORY_INDEX:
+            return "index";
+        case MEMORY_CATEGORY_TEXTURE:
+            return "texture";
+        case MEMORY_CATEGORY_UNIFORM:
+            return "uniform";
+        case MEMORY_CATEGORY_STAGING:
+            return "staging";
+        case MEMORY_CATEGORY_ATTACHMENT:
+            return "attachment";
+        case MEMORY_CATEGORY_STORAGE:
+            return "storage";
+        default:
+            return "other";
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "PhysicalDevice.h"
+#include "Library/Structs/Memory.h"
+
+namespace vk
+{
+    bool CheckMemoryBudgetSupport(VkPhysicalDevice physicalDevice);
+
+    void InitializeMemoryTracker(VkPhysicalDevice physicalDevice,
+        bool memoryBudgetEnabled);
+
+    void RegisterBufferMemoryCategory(VkBuffer buffer,
+        VkBufferUsageFlags usage);
+
+    void RegisterImageMemoryCategory(VkImage image,
+        VkImageUsageFlags usage);
+
+    void UnregisterBufferMemoryCategory(VkBuffer buffer);
+
+    void UnregisterImageMemoryCategory(VkImage image);
+
+    void TrackBufferMemoryAllocation(VkBuffer buffer,
+        VkDeviceMemory memoryObject,
+        uint32_t memoryTypeIndex,
+        VkDeviceSize size);
+
+    void TrackImageMemoryAllocation(VkImage image,
+        VkDeviceMemory memoryObject,
+        uint32_t memoryTypeIndex,
+        VkDeviceSize size);
+
+    void UntrackMemoryAllocation(VkDeviceMemory memoryObject);
+
+    void GetMemoryStats(MemoryStats& stats);
+
+    void LogMemoryStats();
+
+    const char* GetMemoryCategoryName(MemoryCategory category);
+}
@@ -5,14 +5,22 @@ namespace vk
     void CreateShaderModule(VkDevice device, 
         std::vector<unsigned char>& sourceCode, 
         VkShaderModule& shaderModule)
+    {
+        CreateShaderModule(device, sourceCode.data(), sourceCode.size(), shaderModule);
+    }
+
+    void CreateShaderModule(VkDevice device,
+        const unsigned char* sourceCode,
+        size_t sourceCodeSize,
+        VkShaderModule& shaderModule)
     {
         VkShaderModuleCreateInfo moduleInfo =
         {
             VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
             nullptr,
             0, 
-            sourceCode.size(),
-            reinterpret_cast<uint32_t const *>(sourceCode.data())
+            sourceCodeSize,
+            reinterpret_cast<uint32_t const *>(sourceCode)
         };
 
         VK_CHECK_RESULT(vkCreateShaderModule(device, &moduleInfo, nullptr, &shaderModule));
@@ -37,6 +45,42 @@ namespace vk
         }
     }
 
+    void AddSpecializationConstant(uint32_t constantID,
+        const void* value,
+        size_t size,
+        SpecializationConstants& constants)
+    {
+        uint32_t offset = static_cast<uint32_t>(constants.data.size());
+        constants.mapEntries.push_back(
+            {
+                constantID,
+                offset,
+                size
+            });
+
+        const unsigned char* bytes = static_cast<const unsigned char*>(value);
+        constants.data.insert(constants.data.end(), bytes, bytes + size);
+    }
+
+    void SpecifySpecializationInfo(SpecializationConstants& constants)
+    {
+        constants.info =
+        {
+            static_cast<uint32_t>(constants.mapEntries.size()),
+            constants.mapEntries.data(),
+            constants.data.size(),
+            constants.data.data()
+        };
+    }
+
+    uint64_t GetSpecializationVariantKey(const VkSpecializationInfo& specialization,
+        uint64_t seed)
+    {
+        uint64_t key = HashBytes(specialization.pMapEntries,
+            specialization.mapEntryCount * sizeof(VkSpecializationMapEntry), seed);
+        return HashBytes(specialization.pData, specialization.dataSize, key);
+    }
+
     void SpecifyPipelineVertexInputState(std::vector<VkVertexInputBindingDescription>& bindDescriptions, 
         std::vector<VkVertexInputAttributeDescription>& attributes, 
         VkPipelineVertexInputStateCreateInfo& stateInfo)
@@ -245,6 +289,12 @@ namespace vk
         int32_t basepipelineIndex, 
         VkGraphicsPipelineCreateInfo& graphicsPipelineCreateinfo)
     {
+        //a base pipeline is only honoured when the derivative flag is set
+        if (basePipelineHandle != VK_NULL_HANDLE || basepipelineIndex != -1)
+        {
+            additionalOptions |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+        }
+
         graphicsPipelineCreateinfo = 
         {
             VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
@@ -337,6 +387,11 @@ namespace vk
         VkPipelineCache cache, 
         VkPipeline& computePipeline)
     {
+        if (basePipeline != VK_NULL_HANDLE)
+        {
+            additionalOptions |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+        }
+
         VkComputePipelineCreateInfo info =
         {
             VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
@@ -518,6 +573,7 @@ namespace vk
     }
 
     bool CreateMultipleGraphicsPipelinesOnMultipleThreads(VkDevice device, 
+        JobSystem& jobSystem,
         std::string& pipelineCacheFile, 
         std::vector<std::vector<VkGraphicsPipelineCreateInfo>>& pipelinesInfos, 
         std::vector<std::vector<VkPipeline>>& graphicsPipelines)
@@ -534,25 +590,19 @@ namespace vk
             CreatePipelineCacheObject(device, cacheData, caches[i]);
         }
 
-        std::vector<std::thread>threads (pipelinesInfos.size());
-        for (size_t i = 0; i < pipelinesInfos.size(); i++)
-        {
-            graphicsPipelines[i].resize(pipelinesInfos[i].size());
-            threads[i] = std::thread(CreateGraphicsPipelines, device, std::ref(pipelinesInfos[i]), caches[i],
-                std::ref(graphicsPipelines[i]));
-        }
-
-        for (size_t i = 0; i < pipelinesInfos.size(); i++)
+        //every group builds against its own cache, so the groups share the job system without locking
+        graphicsPipelines.resize(pipelinesInfos.size());
+        ParallelFor(jobSystem, static_cast<uint32_t>(pipelinesInfos.size()), 1,
+            [&](uint32_t begin, uint32_t end, uint32_t)
         {
-            threads[i].join();
-        }
+            for (uint32_t i = begin; i < end; i++)
+            {
+                CreateGraphicsPipelines(device, pipelinesInfos[i], caches[i], graphicsPipelines[i]);
+            }
+        });
 
         VkPipelineCache targetCache = caches.back();
-        std::vector<VkPipelineCache> srcCaches(caches.size() - 1);
-        for (size_t i = 0; i < caches.size(); i++)
-        {
-            srcCaches[i] = caches[i];
-        }
+        std::vector<VkPipelineCache> srcCaches(caches.begin(), caches.end() - 1);
 
         MergeMultiplePipelineCacheObjects(device, targetCache, srcCaches);
         RetrieveDataFromPipelineCache(device, targetCache, cacheData);
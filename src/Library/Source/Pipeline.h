@@ -9,6 +9,7 @@
 #include "DescriptorSets.h"
 #include "Library/Structs/Pipeline.h"
 #include "Library/Common/Tools.h"
+#include "Library/Common/JobSystem.h"
 
 namespace vk
 {
@@ -16,9 +17,24 @@ namespace vk
         std::vector<unsigned char>& sourceCode,
         VkShaderModule& shaderModule);
 
+    void CreateShaderModule(VkDevice device,
+        const unsigned char* sourceCode,
+        size_t sourceCodeSize,
+        VkShaderModule& shaderModule);
+
     void SpecifyPipelineShaderStages(std::vector<ShaderStageParams>& shaderStageParams,
         std::vector<VkPipelineShaderStageCreateInfo>& shaderStageInfo);
 
+    void AddSpecializationConstant(uint32_t constantID,
+        const void* value,
+        size_t size,
+        SpecializationConstants& constants);
+
+    void SpecifySpecializationInfo(SpecializationConstants& constants);
+
+    uint64_t GetSpecializationVariantKey(const VkSpecializationInfo& specialization,
+        uint64_t seed = 14695981039346656037ull);
+
     void SpecifyPipelineVertexInputState(std::vector<VkVertexInputBindingDescription>& bindDescriptions,
         std::vector<VkVertexInputAttributeDescription>& attributes,
         VkPipelineVertexInputStateCreateInfo& stateInfo);
@@ -97,7 +113,7 @@ namespace vk
         VkGraphicsPipelineCreateInfo& graphicsPipelineCreateinfo);
 
     void CreatePipelineCacheObject(VkDevice device,
-        std::vector<unsigned char*>& cacheData,
+        std::vector<unsigned char>& cacheData,
         VkPipelineCache& cache);
 
     bool RetrieveDataFromPipelineCache(VkDevice device,
@@ -153,6 +169,7 @@ namespace vk
         std::vector<VkPipeline>& graphicsPipeline);
 
     bool CreateMultipleGraphicsPipelinesOnMultipleThreads(VkDevice device,
+        JobSystem& jobSystem,
         std::string& pipelineCacheFile,
         std::vector<std::vector<VkGraphicsPipelineCreateInfo>>& pipelinesInfos,
         std::vector<std::vector<VkPipeline>>& graphicsPipelines);
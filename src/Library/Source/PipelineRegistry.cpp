@@ -0,0 +1,490 @@
+#include "PipelineRegistry.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace vk
+{
+    void CreatePipelineRegistry(VkDevice device,
+        std::vector<unsigned char>& cacheData,
+        PipelineRegistry& registry)
+    {
+        registry.pipelines.clear();
+        CreatePipelineCacheObject(device, cacheData, registry.cache);
+    }
+
+    static const VkPipelineCreateFlags derivativeFlags =
+        VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT | VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+
+    static bool IsStateDynamic(const VkGraphicsPipelineCreateInfo& pipelineInfo,
+        VkDynamicState state)
+    {
+        if (pipelineInfo.pDynamicState == nullptr)
+        {
+            return false;
+        }
+
+        const VkPipelineDynamicStateCreateInfo& dynamicState = *pipelineInfo.pDynamicState;
+        for (uint32_t i = 0; i < dynamicState.dynamicStateCount; i++)
+        {
+            if (dynamicState.pDynamicStates[i] == state)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //values set by the command buffer do not change the pipeline, so they stay out of the key
+    template<typename T>
+    static uint64_t HashDynamicValue(const VkGraphicsPipelineCreateInfo& pipelineInfo,
+        VkDynamicState state,
+        const T& value,
+        uint64_t hash)
+    {
+        return IsStateDynamic(pipelineInfo, state) ? hash : HashValue(value, hash);
+    }
+
+    static VkPrimitiveTopology GetTopologyClass(VkPrimitiveTopology topology)
+    {
+        switch (topology)
+        {
+        case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+            return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+        case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST:
+        case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP:
+        case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN:
+        case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_WITH_ADJACENCY:
+        case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY:
+            return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        default:
+            return topology;
+        }
+    }
+
+    //variant state (blend, depth and specialization) is left out of the family key
+    static uint64_t HashGraphicsPipeline(const VkGraphicsPipelineCreateInfo& pipelineInfo,
+        bool includeVariantState)
+    {
+        uint64_t hash = HashValue(pipelineInfo.flags & ~derivativeFlags, 14695981039346656037ull);
+
+        //shader stages together with their specialization constants form the variant key
+        for (uint32_t i = 0; i < pipelineInfo.stageCount; i++)
+        {
+            const VkPipelineShaderStageCreateInfo& stage = pipelineInfo.pStages[i];
+            hash = HashValue(stage.stage, hash);
+            hash = HashValue(stage.module, hash);
+            hash = HashBytes(stage.pName, std::strlen(stage.pName), hash);
+
+            if (includeVariantState && stage.pSpecializationInfo != nullptr)
+            {
+                hash = GetSpecializationVariantKey(*stage.pSpecializationInfo, hash);
+            }
+        }
+
+        if (pipelineInfo.pVertexInputState != nullptr)
+        {
+            const VkPipelineVertexInputStateCreateInfo& vertexInput = *pipelineInfo.pVertexInputState;
+            hash = HashBytes(vertexInput.pVertexBindingDescriptions,
+                vertexInput.vertexBindingDescriptionCount * sizeof(VkVertexInputBindingDescription), hash);
+            hash = HashBytes(vertexInput.pVertexAttributeDescriptions,
+                vertexInput.vertexAttributeDescriptionCount * sizeof(VkVertexInputAttributeDescription), hash);
+        }
+
+        if (pipelineInfo.pInputAssemblyState != nullptr)
+        {
+            //with a dynamic topology only its class has to match the pipeline
+            VkPrimitiveTopology topology = pipelineInfo.pInputAssemblyState->topology;
+            if (IsStateDynamic(pipelineInfo, VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY))
+            {
+                topology = GetTopologyClass(topology);
+            }
+            hash = HashValue(topology, hash);
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE,
+                pipelineInfo.pInputAssemblyState->primitiveRestartEnable, hash);
+        }
+
+        if (pipelineInfo.pTessellationState != nullptr)
+        {
+            hash = HashValue(pipelineInfo.pTessellationState->patchControlPoints, hash);
+        }
+
+        if (pipelineInfo.pViewportState != nullptr)
+        {
+            hash = HashValue(pipelineInfo.pViewportState->viewportCount, hash);
+            hash = HashValue(pipelineInfo.pViewportState->scissorCount, hash);
+        }
+
+        if (pipelineInfo.pRasterizationState != nullptr)
+        {
+            const VkPipelineRasterizationStateCreateInfo& rasterization = *pipelineInfo.pRasterizationState;
+            hash = HashValue(rasterization.depthClampEnable, hash);
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE, rasterization.rasterizerDiscardEnable, hash);
+#ifdef VK_EXT_extended_dynamic_state3
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_POLYGON_MODE_EXT, rasterization.polygonMode, hash);
+#else
+            hash = HashValue(rasterization.polygonMode, hash);
+#endif
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_CULL_MODE, rasterization.cullMode, hash);
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_FRONT_FACE, rasterization.frontFace, hash);
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE, rasterization.depthBiasEnable, hash);
+            if (!IsStateDynamic(pipelineInfo, VK_DYNAMIC_STATE_DEPTH_BIAS))
+            {
+                hash = HashValue(rasterization.depthBiasConstantFactor, hash);
+                hash = HashValue(rasterization.depthBiasClamp, hash);
+                hash = HashValue(rasterization.depthBiasSlopeFactor, hash);
+            }
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_LINE_WIDTH, rasterization.lineWidth, hash);
+        }
+
+        if (pipelineInfo.pMultisampleState != nullptr)
+        {
+            const VkPipelineMultisampleStateCreateInfo& multisample = *pipelineInfo.pMultisampleState;
+            hash = HashValue(multisample.rasterizationSamples, hash);
+            hash = HashValue(multisample.sampleShadingEnable, hash);
+            hash = HashValue(multisample.minSampleShading, hash);
+            hash = HashValue(multisample.alphaToCoverageEnable, hash);
+            hash = HashValue(multisample.alphaToOneEnable, hash);
+        }
+
+        if (includeVariantState && pipelineInfo.pDepthStencilState != nullptr)
+        {
+            const VkPipelineDepthStencilStateCreateInfo& depthStencil = *pipelineInfo.pDepthStencilState;
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE, depthStencil.depthTestEnable, hash);
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE, depthStencil.depthWriteEnable, hash);
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_DEPTH_COMPARE_OP, depthStencil.depthCompareOp, hash);
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE, depthStencil.depthBoundsTestEnable, hash);
+            hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE, depthStencil.stencilTestEnable, hash);
+            for (auto stencil : { depthStencil.front, depthStencil.back })
+            {
+                if (!IsStateDynamic(pipelineInfo, VK_DYNAMIC_STATE_STENCIL_OP))
+                {
+                    hash = HashValue(stencil.failOp, hash);
+                    hash = HashValue(stencil.passOp, hash);
+                    hash = HashValue(stencil.depthFailOp, hash);
+                    hash = HashValue(stencil.compareOp, hash);
+                }
+                hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK, stencil.compareMask, hash);
+                hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_STENCIL_WRITE_MASK, stencil.writeMask, hash);
+                hash = HashDynamicValue(pipelineInfo, VK_DYNAMIC_STATE_STENCIL_REFERENCE, stencil.reference, hash);
+            }
+            if (!IsStateDynamic(pipelineInfo, VK_DYNAMIC_STATE_DEPTH_BOUNDS))
+            {
+                hash = HashValue(depthStencil.minDepthBounds, hash);
+                hash = HashValue(depthStencil.maxDepthBounds, hash);
+            }
+        }
+
+        if (includeVariantState && pipelineInfo.pColorBlendState != nullptr)
+        {
+            const VkPipelineColorBlendStateCreateInfo& blend = *pipelineInfo.pColorBlendState;
+            hash = HashValue(blend.logicOpEnable, hash);
+            hash = HashValue(blend.logicOp, hash);
+            hash = HashBytes(blend.pAttachments,
+                blend.attachmentCount * sizeof(VkPipelineColorBlendAttachmentState), hash);
+            if (!IsStateDynamic(pipelineInfo, VK_DYNAMIC_STATE_BLEND_CONSTANTS))
+            {
+                hash = HashBytes(blend.blendConstants, sizeof(blend.blendConstants), hash);
+            }
+        }
+
+        if (pipelineInfo.pDynamicState != nullptr)
+        {
+            hash = HashBytes(pipelineInfo.pDynamicState->pDynamicStates,
+                pipelineInfo.pDynamicState->dynamicStateCount * sizeof(VkDynamicState), hash);
+        }
+
+        hash = HashValue(pipelineInfo.layout, hash);
+        hash = HashValue(pipelineInfo.renderPass, hash);
+        hash = HashValue(pipelineInfo.subpass, hash);
+
+        return hash;
+    }
+
+    uint64_t HashGraphicsPipelineState(const VkGraphicsPipelineCreateInfo& pipelineInfo)
+    {
+        return HashGraphicsPipeline(pipelineInfo, true);
+    }
+
+    uint64_t HashGraphicsPipelineFamily(const VkGraphicsPipelineCreateInfo& pipelineInfo)
+    {
+        return HashGraphicsPipeline(pipelineInfo, false);
+    }
+
+    bool FindPipelineInRegistry(const PipelineRegistry& registry,
+        uint64_t key,
+        VkPipeline& pipeline)
+    {
+        auto found = registry.pipelines.find(key);
+        if (found == registry.pipelines.end())
+        {
+            return false;
+        }
+
+        pipeline = found->second;
+        return true;
+    }
+
+    void GetOrCreateGraphicsPipeline(VkDevice device,
+        PipelineRegistry& registry,
+        const VkGraphicsPipelineCreateInfo& pipelineInfo,
+        VkPipeline& pipeline)
+    {
+        uint64_t key = HashGraphicsPipelineState(pipelineInfo);
+        if (FindPipelineInRegistry(registry, key, pipeline))
+        {
+            return;
+        }
+
+        std::vector<VkPipeline> pipelines;
+        CreateGraphicsPipelines(device, { pipelineInfo }, registry.cache, pipelines);
+
+        pipeline = pipelines[0];
+        registry.pipelines[key] = pipeline;
+    }
+
+    bool CreateGraphicsPipelineFamily(VkDevice device,
+        PipelineRegistry& registry,
+        const std::vector<VkGraphicsPipelineCreateInfo>& variantsInfo,
+        std::vector<VkPipeline>& pipelines)
+    {
+        if (variantsInfo.empty())
+        {
+            return false;
+        }
+
+        uint64_t familyKey = HashGraphicsPipelineFamily(variantsInfo[0]);
+        for (auto& info : variantsInfo)
+        {
+            if (HashGraphicsPipelineFamily(info) != familyKey)
+            {
+                WARN_LOG("Pipeline variants differ in more than blend, depth or specialization state and cannot share a base pipeline");
+                return false;
+            }
+        }
+
+        PipelineFamily& family = registry.families[familyKey];
+
+        //collect the variants which are not in the registry yet, skipping duplicates within the batch
+        pipelines.assign(variantsInfo.size(), VK_NULL_HANDLE);
+        std::vector<VkGraphicsPipelineCreateInfo> newInfos;
+        std::vector<uint64_t> newKeys;
+        std::unordered_map<uint64_t, size_t> batchIndices;
+        std::vector<size_t> variantBatchIndex(variantsInfo.size(), 0);
+
+        for (size_t i = 0; i < variantsInfo.size(); i++)
+        {
+            uint64_t key = HashGraphicsPipelineState(variantsInfo[i]);
+            if (FindPipelineInRegistry(registry, key, pipelines[i]))
+            {
+                continue;
+            }
+
+            auto found = batchIndices.find(key);
+            if (found != batchIndices.end())
+            {
+                variantBatchIndex[i] = found->second;
+                continue;
+            }
+
+            batchIndices[key] = newInfos.size();
+            variantBatchIndex[i] = newInfos.size();
+            newInfos.push_back(variantsInfo[i]);
+            newKeys.push_back(key);
+        }
+
+        if (newInfos.empty())
+        {
+            return true;
+        }
+
+        //the first pipeline of a new family is the base, the others derive from it inside the same call
+        for (size_t i = 0; i < newInfos.size(); i++)
+        {
+            VkGraphicsPipelineCreateInfo& info = newInfos[i];
+            info.flags &= ~derivativeFlags;
+
+            if (family.basePipeline != VK_NULL_HANDLE)
+            {
+                info.flags |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+                info.basePipelineHandle = family.basePipeline;
+                info.basePipelineIndex = -1;
+            }
+            else if (i == 0)
+            {
+                info.flags |= VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT;
+                info.basePipelineHandle = VK_NULL_HANDLE;
+                info.basePipelineIndex = -1;
+            }
+            else
+            {
+                info.flags |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+                info.basePipelineHandle = VK_NULL_HANDLE;
+                info.basePipelineIndex = 0;
+            }
+        }
+
+        std::vector<VkPipeline> createdPipelines;
+        CreateGraphicsPipelines(device, newInfos, registry.cache, createdPipelines);
+
+        if (family.basePipeline == VK_NULL_HANDLE)
+        {
+            family.basePipeline = createdPipelines[0];
+        }
+
+        for (size_t i = 0; i < createdPipelines.size(); i++)
+        {
+            registry.pipelines[newKeys[i]] = createdPipelines[i];
+            family.variants.push_back(createdPipelines[i]);
+        }
+
+        for (size_t i = 0; i < pipelines.size(); i++)
+        {
+            if (pipelines[i] == VK_NULL_HANDLE)
+            {
+                pipelines[i] = createdPipelines[variantBatchIndex[i]];
+            }
+        }
+
+        return true;
+    }
+
+    void MeasurePipelineFamilyCreation(VkDevice device,
+        const std::vector<VkGraphicsPipelineCreateInfo>& variantsInfo,
+        PipelineCreationTimings& timings)
+    {
+        timings = {};
+        if (variantsInfo.empty())
+        {
+            return;
+        }
+
+        //no pipeline cache is used so that neither run benefits from the other one
+        std::vector<VkGraphicsPipelineCreateInfo> derivativeInfos = variantsInfo;
+        for (size_t i = 0; i < derivativeInfos.size(); i++)
+        {
+            derivativeInfos[i].flags &= ~derivativeFlags;
+            derivativeInfos[i].flags |= i == 0 ? VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT : VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+            derivativeInfos[i].basePipelineHandle = VK_NULL_HANDLE;
+            derivativeInfos[i].basePipelineIndex = i == 0 ? -1 : 0;
+        }
+
+        std::vector<VkPipeline> pipelines;
+        auto start = std::chrono::steady_clock::now();
+        CreateGraphicsPipelines(device, derivativeInfos, VK_NULL_HANDLE, pipelines);
+        auto end = std::chrono::steady_clock::now();
+        timings.batchedDerivativesMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+        for (auto& pipeline : pipelines)
+        {
+            DestroyPipeline(device, pipeline);
+        }
+
+        std::vector<VkPipeline> independentPipelines;
+        start = std::chrono::steady_clock::now();
+        for (auto info : variantsInfo)
+        {
+            info.flags &= ~derivativeFlags;
+            info.basePipelineHandle = VK_NULL_HANDLE;
+            info.basePipelineIndex = -1;
+
+            CreateGraphicsPipelines(device, { info }, VK_NULL_HANDLE, pipelines);
+            independentPipelines.push_back(pipelines[0]);
+        }
+        end = std::chrono::steady_clock::now();
+        timings.independentMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+        for (auto& pipeline : independentPipelines)
+        {
+            DestroyPipeline(device, pipeline);
+        }
+
+        INFO_LOG("Pipeline family of " + std::to_string(variantsInfo.size()) + " variants: " +
+            std::to_string(timings.batchedDerivativesMs) + " ms batched with derivatives, " +
+            std::to_string(timings.independentMs) + " ms created independently");
+    }
+
+    RegisteredPipeline GetRegisteredPipeline(const VkGraphicsPipelineCreateInfo& pipelineInfo,
+        VkPipeline pipeline)
+    {
+        return { pipeline, HashGraphicsPipelineState(pipelineInfo), HashGraphicsPipelineFamily(pipelineInfo) };
+    }
+
+    VkPipeline ReplacePipelineInRegistry(PipelineRegistry& registry,
+        VkPipeline oldPipeline,
+        const RegisteredPipeline& newPipeline)
+    {
+        //the keys hash the shader modules, so the old entries would never be found again
+        for (auto entry = registry.pipelines.begin(); entry != registry.pipelines.end();)
+        {
+            if (entry->second == oldPipeline)
+            {
+                entry = registry.pipelines.erase(entry);
+            }
+            else
+            {
+                entry++;
+            }
+        }
+
+        //a stale entry under the same key is handed back to the caller instead of being overwritten and leaked
+        VkPipeline displacedPipeline = VK_NULL_HANDLE;
+        auto collision = registry.pipelines.find(newPipeline.key);
+        if (collision != registry.pipelines.end() && collision->second != newPipeline.pipeline)
+        {
+            displacedPipeline = collision->second;
+        }
+        registry.pipelines[newPipeline.key] = newPipeline.pipeline;
+
+        //a replaced base keeps serving as the parent of its family only while it is alive
+        for (auto entry = registry.families.begin(); entry != registry.families.end();)
+        {
+            PipelineFamily& family = entry->second;
+            if (family.basePipeline == oldPipeline || family.basePipeline == displacedPipeline)
+            {
+                family.basePipeline = VK_NULL_HANDLE;
+            }
+
+            for (auto variant = family.variants.begin(); variant != family.variants.end();)
+            {
+                if (*variant == oldPipeline || *variant == displacedPipeline)
+                {
+                    variant = family.variants.erase(variant);
+                }
+                else
+                {
+                    variant++;
+                }
+            }
+
+            if (family.variants.empty())
+            {
+                entry = registry.families.erase(entry);
+            }
+            else
+            {
+                entry++;
+            }
+        }
+
+        //the new pipeline was not created as a base, so it only joins the family as a variant
+        registry.families[newPipeline.familyKey].variants.push_back(newPipeline.pipeline);
+        return displacedPipeline;
+    }
+
+    void DestroyPipelineRegistry(VkDevice device,
+        PipelineRegistry& registry)
+    {
+        for (auto& entry : registry.pipelines)
+        {
+            DestroyPipeline(device, entry.second);
+        }
+        registry.pipelines.clear();
+        registry.families.clear();
+
+        DestroyPipelineCache(device, registry.cache);
+    }
+}
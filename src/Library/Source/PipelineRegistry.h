@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "LogicalDevice.h"
+#include "Pipeline.h"
+#include "Library/Structs/Pipeline.h"
+#include "Library/Common/Tools.h"
+
+namespace vk
+{
+    void CreatePipelineRegistry(VkDevice device,
+        std::vector<unsigned char>& cacheData,
+        PipelineRegistry& registry);
+
+    uint64_t HashGraphicsPipelineState(const VkGraphicsPipelineCreateInfo& pipelineInfo);
+
+    uint64_t HashGraphicsPipelineFamily(const VkGraphicsPipelineCreateInfo& pipelineInfo);
+
+    bool FindPipelineInRegistry(const PipelineRegistry& registry,
+        uint64_t key,
+        VkPipeline& pipeline);
+
+    void GetOrCreateGraphicsPipeline(VkDevice device,
+        PipelineRegistry& registry,
+        const VkGraphicsPipelineCreateInfo& pipelineInfo,
+        VkPipeline& pipeline);
+
+    bool CreateGraphicsPipelineFamily(VkDevice device,
+        PipelineRegistry& registry,
+        const std::vector<VkGraphicsPipelineCreateInfo>& variantsInfo,
+        std::vector<VkPipeline>& pipelines);
+
+    void MeasurePipelineFamilyCreation(VkDevice device,
+        const std::vector<VkGraphicsPipelineCreateInfo>& variantsInfo,
+        PipelineCreationTimings& timings);
+
+    RegisteredPipeline GetRegisteredPipeline(const VkGraphicsPipelineCreateInfo& pipelineInfo,
+        VkPipeline pipeline);
+
+    VkPipeline ReplacePipelineInRegistry(PipelineRegistry& registry,
+        VkPipeline oldPipeline,
+        const RegisteredPipeline& newPipeline);
+
+    void DestroyPipelineRegistry(VkDevice device,
+        PipelineRegistry& registry);
+}
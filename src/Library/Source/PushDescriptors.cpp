@@ -0,0 +1,158 @@
+#include "PushDescriptors.h"
+
+namespace vk
+{
+    static PFN_vkCmdPushDescriptorSetKHR cmdPushDescriptorSet = nullptr;
+    static uint32_t maxPushDescriptors = 0;
+
+    bool CheckPushDescriptorSupport(VkPhysicalDevice physicalDevice)
+    {
+        std::vector<VkExtensionProperties> availableExtensions;
+        if (!CheckAvailableDeviceExtensions(physicalDevice, availableExtensions))
+        {
+            return false;
+        }
+
+        return IsExtensionSupported(availableExtensions, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    }
+
+    void LoadPushDescriptorFunctions(VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        bool enabled)
+    {
+        cmdPushDescriptorSet = nullptr;
+        maxPushDescriptors = 0;
+        if (!enabled)
+        {
+            return;
+        }
+
+        cmdPushDescriptorSet = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(device, "vkCmdPushDescriptorSetKHR");
+        if (cmdPushDescriptorSet == nullptr)
+        {
+            WARN_LOG("Could not load vkCmdPushDescriptorSetKHR, falling back to allocated descriptor sets");
+            return;
+        }
+
+        VkPhysicalDevicePushDescriptorPropertiesKHR pushProperties =
+        {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR
+        };
+        VkPhysicalDeviceProperties2 properties2 =
+        {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            &pushProperties
+        };
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+        maxPushDescriptors = pushProperties.maxPushDescriptors;
+    }
+
+    bool IsPushDescriptorAvailable()
+    {
+        return cmdPushDescriptorSet != nullptr;
+    }
+
+    bool CanPushDescriptors(uint32_t descriptorCount)
+    {
+        return IsPushDescriptorAvailable() && descriptorCount <= maxPushDescriptors;
+    }
+
+    VkDescriptorSetLayoutCreateFlags GetPushDescriptorLayoutFlags(const std::vector<VkDescriptorSetLayoutBinding>& bindings)
+    {
+        //a layout with more descriptors than the device can push stays a regular one
+        uint32_t descriptorCount = 0;
+        for (auto& binding : bindings)
+        {
+            descriptorCount += binding.descriptorCount;
+        }
+        return CanPushDescriptors(descriptorCount) ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
+    }
+
+    bool PushDescriptorSet(VkDevice device,
+        VkCommandBuffer commandBuffer,
+        DescriptorAllocator& frameAllocator,
+        VkPipelineBindPoint pipelineType,
+        VkPipelineLayout layout,
+        uint32_t setIndex,
+        VkDescriptorSetLayout descriptorSetLayout,
+        const std::vector<ImageDescriptorInfo>& imageInfo,
+        const std::vector<BufferDescriptorInfo>& bufferInfo)
+    {
+        //the writes cover the whole layout, so they are checked against the same limit its flags were chosen with
+        uint32_t descriptorCount = 0;
+        for (auto& image : imageInfo)
+        {
+            descriptorCount += static_cast<uint32_t>(image.imageInfo.size());
+        }
+        for (auto& buffer : bufferInfo)
+        {
+            descriptorCount += static_cast<uint32_t>(buffer.bufferInfo.size());
+        }
+
+        //without push descriptors a transient set comes from the frame allocator and is released with the frame
+        if (!CanPushDescriptors(descriptorCount))
+        {
+            std::vector<VkDescriptorSet> sets;
+            if (!AllocateDescriptorSetsFromAllocator(device, frameAllocator, { descriptorSetLayout }, sets))
+            {
+                return false;
+            }
+
+            std::vector<ImageDescriptorInfo> imageWrites = imageInfo;
+            for (auto& image : imageWrites)
+            {
+                image.descriptorSet = sets[0];
+            }
+            std::vector<BufferDescriptorInfo> bufferWrites = bufferInfo;
+            for (auto& buffer : bufferWrites)
+            {
+                buffer.descriptorSet = sets[0];
+            }
+
+            UpdateDescriptorSets(device, imageWrites, bufferWrites, {}, {});
+            BindDescitorSets(commandBuffer, pipelineType, layout, setIndex, sets, {});
+            return true;
+        }
+
+        std::vector<VkWriteDescriptorSet> writeDescriptors;
+        for (auto& image : imageInfo)
+        {
+            writeDescriptors.push_back(
+                {
+                    VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                    nullptr,
+                    VK_NULL_HANDLE,
+                    image.binding,
+                    image.arrayElement,
+                    static_cast<uint32_t>(image.imageInfo.size()),
+                    image.descriptorType,
+                    image.imageInfo.data(),
+                    nullptr,
+                    nullptr
+                }
+            );
+        }
+
+        for (auto& buffer : bufferInfo)
+        {
+            writeDescriptors.push_back(
+                {
+                    VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                    nullptr,
+                    VK_NULL_HANDLE,
+                    buffer.binding,
+                    buffer.arrayElement,
+                    static_cast<uint32_t>(buffer.bufferInfo.size()),
+                    buffer.descriptorType,
+                    nullptr,
+                    buffer.bufferInfo.data(),
+                    nullptr
+                }
+            );
+        }
+
+        cmdPushDescriptorSet(commandBuffer, pipelineType, layout, setIndex,
+            static_cast<uint32_t>(writeDescriptors.size()), writeDescriptors.data());
+        return true;
+    }
+}
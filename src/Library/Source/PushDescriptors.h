@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "Instance.h"
+#include "PhysicalDevice.h"
+#include "DescriptorSets.h"
+#include "DescriptorAllocator.h"
+#include "Library/Structs/Buffer.h"
+#include "Library/Structs/Image.h"
+
+namespace vk
+{
+    bool CheckPushDescriptorSupport(VkPhysicalDevice physicalDevice);
+
+    void LoadPushDescriptorFunctions(VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        bool enabled);
+
+    bool IsPushDescriptorAvailable();
+
+    bool CanPushDescriptors(uint32_t descriptorCount);
+
+    VkDescriptorSetLayoutCreateFlags GetPushDescriptorLayoutFlags(const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+
+    bool PushDescriptorSet(VkDevice device,
+        VkCommandBuffer commandBuffer,
+        DescriptorAllocator& frameAllocator,
+        VkPipelineBindPoint pipelineType,
+        VkPipelineLayout layout,
+        uint32_t setIndex,
+        VkDescriptorSetLayout descriptorSetLayout,
+        const std::vector<ImageDescriptorInfo>& imageInfo,
+        const std::vector<BufferDescriptorInfo>& bufferInfo);
+}
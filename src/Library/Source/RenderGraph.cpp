@@ -0,0 +1,1024 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+
+namespace vk
+{
+    static bool IsAttachmentUsage(RenderGraphUsage usage)
+    {
+        return usage == RENDER_GRAPH_USAGE_COLOR_ATTACHMENT ||
+            usage == RENDER_GRAPH_USAGE_DEPTH_ATTACHMENT ||
+            usage == RENDER_GRAPH_USAGE_DEPTH_READ_ONLY_ATTACHMENT ||
+            usage == RENDER_GRAPH_USAGE_INPUT_ATTACHMENT;
+    }
+
+    static bool IsWriteUsage(RenderGraphUsage usage)
+    {
+        return usage == RENDER_GRAPH_USAGE_COLOR_ATTACHMENT ||
+            usage == RENDER_GRAPH_USAGE_DEPTH_ATTACHMENT ||
+            usage == RENDER_GRAPH_USAGE_STORAGE_IMAGE_WRITE ||
+            usage == RENDER_GRAPH_USAGE_TRANSFER_DST ||
+            usage == RENDER_GRAPH_USAGE_STORAGE_BUFFER_WRITE;
+    }
+
+    static VkImageUsageFlags GetRenderGraphImageUsage(RenderGraphUsage usage)
+    {
+        switch (usage)
+        {
+        case RENDER_GRAPH_USAGE_COLOR_ATTACHMENT:
+            return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        case RENDER_GRAPH_USAGE_DEPTH_ATTACHMENT:
+        case RENDER_GRAPH_USAGE_DEPTH_READ_ONLY_ATTACHMENT:
+            return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        case RENDER_GRAPH_USAGE_INPUT_ATTACHMENT:
+            return VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+        case RENDER_GRAPH_USAGE_SAMPLED_IMAGE:
+            return VK_IMAGE_USAGE_SAMPLED_BIT;
+        case RENDER_GRAPH_USAGE_STORAGE_IMAGE_READ:
+        case RENDER_GRAPH_USAGE_STORAGE_IMAGE_WRITE:
+            return VK_IMAGE_USAGE_STORAGE_BIT;
+        case RENDER_GRAPH_USAGE_TRANSFER_SRC:
+            return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        case RENDER_GRAPH_USAGE_TRANSFER_DST:
+            return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        default:
+            return 0;
+        }
+    }
+
+    static void SpecifyRenderGraphResourceUse(const RenderGraphAccess& access,
+        VkPipelineBindPoint bindPoint,
+        RenderGraphResourceUse& use)
+    {
+        //graphics passes sample images in fragment shaders, buffers are also read by vertex shaders
+        VkPipelineStageFlags imageShaderStages = bindPoint == VK_PIPELINE_BIND_POINT_COMPUTE ?
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        VkPipelineStageFlags bufferShaderStages = bindPoint == VK_PIPELINE_BIND_POINT_COMPUTE ?
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+        use.resource = access.resource;
+        use.usage = access.usage;
+        use.write = IsWriteUsage(access.usage);
+        use.attachment = IsAttachmentUsage(access.usage);
+        use.loadOp = access.loadOp;
+        use.clearValue = access.clearValue;
+        use.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        switch (access.usage)
+        {
+        case RENDER_GRAPH_USAGE_COLOR_ATTACHMENT:
+            use.stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            use.access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                (access.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD ? VK_ACCESS_COLOR_ATTACHMENT_READ_BIT : 0);
+            use.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            break;
+        case RENDER_GRAPH_USAGE_DEPTH_ATTACHMENT:
+            use.stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            use.access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            use.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            break;
+        case RENDER_GRAPH_USAGE_DEPTH_READ_ONLY_ATTACHMENT:
+            use.stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            use.access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+            use.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            break;
+        case RENDER_GRAPH_USAGE_INPUT_ATTACHMENT:
+            use.stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            use.access = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
+            use.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            break;
+        case RENDER_GRAPH_USAGE_SAMPLED_IMAGE:
+            use.stages = imageShaderStages;
+            use.access = VK_ACCESS_SHADER_READ_BIT;
+            use.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            break;
+        case RENDER_GRAPH_USAGE_STORAGE_IMAGE_READ:
+            use.stages = imageShaderStages;
+            use.access = VK_ACCESS_SHADER_READ_BIT;
+            use.layout = VK_IMAGE_LAYOUT_GENERAL;
+            break;
+        case RENDER_GRAPH_USAGE_STORAGE_IMAGE_WRITE:
+            use.stages = imageShaderStages;
+            use.access = VK_ACCESS_SHADER_WRITE_BIT;
+            use.layout = VK_IMAGE_LAYOUT_GENERAL;
+            break;
+        case RENDER_GRAPH_USAGE_TRANSFER_SRC:
+            use.stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            use.access = VK_ACCESS_TRANSFER_READ_BIT;
+            use.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            break;
+        case RENDER_GRAPH_USAGE_TRANSFER_DST:
+            use.stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            use.access = VK_ACCESS_TRANSFER_WRITE_BIT;
+            use.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            break;
+        case RENDER_GRAPH_USAGE_UNIFORM_BUFFER:
+            use.stages = bufferShaderStages;
+            use.access = VK_ACCESS_UNIFORM_READ_BIT;
+            break;
+        case RENDER_GRAPH_USAGE_STORAGE_BUFFER_READ:
+            use.stages = bufferShaderStages;
+            use.access = VK_ACCESS_SHADER_READ_BIT;
+            break;
+        case RENDER_GRAPH_USAGE_STORAGE_BUFFER_WRITE:
+            use.stages = bufferShaderStages;
+            use.access = VK_ACCESS_SHADER_WRITE_BIT;
+            break;
+        case RENDER_GRAPH_USAGE_VERTEX_BUFFER:
+            use.stages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+            use.access = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+            break;
+        case RENDER_GRAPH_USAGE_INDEX_BUFFER:
+            use.stages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+            use.access = VK_ACCESS_INDEX_READ_BIT;
+            break;
+        case RENDER_GRAPH_USAGE_INDIRECT_BUFFER:
+            use.stages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+            use.access = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+            break;
+        }
+    }
+
+    static void GetRenderGraphPassUses(const RenderGraph& graph,
+        const RenderGraphPass& pass,
+        std::vector<RenderGraphResourceUse>& uses)
+    {
+        //several usages of one resource in a pass become a single use, so the pass never waits on itself
+        uses.clear();
+        for (auto& access : pass.accesses)
+        {
+            RenderGraphResourceUse use;
+            SpecifyRenderGraphResourceUse(access, pass.bindPoint, use);
+
+            auto existing = std::find_if(uses.begin(), uses.end(),
+                [&](const RenderGraphResourceUse& other) { return other.resource == use.resource; });
+            if (existing == uses.end())
+            {
+                uses.push_back(use);
+                continue;
+            }
+
+            if (existing->layout != use.layout && graph.resources[use.resource].type == RENDER_GRAPH_RESOURCE_IMAGE)
+            {
+                WARN_LOG("Render graph pass '" + pass.name + "' uses '" + graph.resources[use.resource].name +
+                    "' in two different layouts");
+            }
+
+            existing->stages |= use.stages;
+            existing->access |= use.access;
+            existing->write = existing->write || use.write;
+            if (use.attachment && !existing->attachment)
+            {
+                existing->attachment = true;
+                existing->usage = use.usage;
+                existing->layout = use.layout;
+                existing->loadOp = use.loadOp;
+                existing->clearValue = use.clearValue;
+            }
+        }
+    }
+
+    static bool GetRenderGraphPassExtent(const RenderGraph& graph,
+        const RenderGraphPass& pass,
+        VkExtent2D& size)
+    {
+        for (auto& access : pass.accesses)
+        {
+            if (IsAttachmentUsage(access.usage))
+            {
+                size = graph.resources[access.resource].imageInfo.size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool ComputeRenderGraphHazard(RenderGraphResourceState& state,
+        const RenderGraphResourceUse& use,
+        bool image,
+        VkPipelineStageFlags& srcStages,
+        VkAccessFlags& srcAccess)
+    {
+        bool layoutChange = image && state.layout != use.layout;
+        srcStages = 0;
+        srcAccess = 0;
+
+        if (use.write || layoutChange)
+        {
+            //write after read only needs an execution dependency, the reads already saw the previous write
+            srcStages = state.readStages != 0 ? state.readStages : state.writeStages | state.transitionStages;
+            srcAccess = state.readStages != 0 ? 0 : state.writeAccess;
+            bool hazard = srcStages != 0 || layoutChange;
+
+            //the last write stays the source for every later reader, a transition only adds the stages it was ordered with
+            state.layout = use.layout;
+            if (use.write)
+            {
+                state.writeStages = use.stages;
+                state.writeAccess = use.access;
+                state.transitionStages = 0;
+            }
+            else
+            {
+                state.transitionStages = use.stages;
+            }
+            state.readStages = use.write ? 0 : use.stages;
+            state.readAccess = use.write ? 0 : use.access;
+            return hazard;
+        }
+
+        VkPipelineStageFlags lastWriteStages = state.writeStages | state.transitionStages;
+        bool visible = (state.readStages & use.stages) == use.stages && (state.readAccess & use.access) == use.access;
+        bool hazard = lastWriteStages != 0 && !visible;
+        if (hazard)
+        {
+            srcStages = lastWriteStages;
+            srcAccess = state.writeAccess;
+        }
+
+        state.readStages |= use.stages;
+        state.readAccess |= use.access;
+        return hazard;
+    }
+
+    uint32_t AddRenderGraphImage(RenderGraph& graph,
+        const std::string& name,
+        const RenderGraphImageInfo& imageInfo)
+    {
+        graph.resources.push_back(
+            {
+                name,
+                RENDER_GRAPH_RESOURCE_IMAGE,
+                imageInfo,
+                false,
+                VK_NULL_HANDLE,
+                VK_NULL_HANDLE,
+                VK_NULL_HANDLE,
+                0,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                0,
+                0,
+                -1,
+                -1,
+                {}
+            });
+        return static_cast<uint32_t>(graph.resources.size() - 1);
+    }
+
+    uint32_t ImportRenderGraphImage(RenderGraph& graph,
+        const std::string& name,
+        const RenderGraphImageInfo& imageInfo,
+        VkImageLayout initialLayout,
+        VkPipelineStageFlags initialStages,
+        VkAccessFlags initialAccess,
+        VkImageLayout finalLayout)
+    {
+        //the stages are the ones the image is handed over in, e.g. the wait stage of the acquire semaphore for a swapchain image
+        uint32_t resource = AddRenderGraphImage(graph, name, imageInfo);
+        graph.resources[resource].imported = true;
+        graph.resources[resource].initialLayout = initialLayout;
+        graph.resources[resource].initialStages = initialStages;
+        graph.resources[resource].initialAccess = initialAccess;
+        graph.resources[resource].finalLayout = finalLayout;
+        return resource;
+    }
+
+    uint32_t ImportRenderGraphBuffer(RenderGraph& graph,
+        const std::string& name,
+        VkBuffer buffer)
+    {
+        uint32_t resource = AddRenderGraphImage(graph, name, {});
+        graph.resources[resource].type = RENDER_GRAPH_RESOURCE_BUFFER;
+        graph.resources[resource].imported = true;
+        graph.resources[resource].buffer = buffer;
+        return resource;
+    }
+
+    void SetRenderGraphImportedImage(RenderGraph& graph,
+        uint32_t resource,
+        VkImage image,
+        VkImageView view)
+    {
+        //swapchain images change every frame, the compiled barriers and render passes stay the same
+        graph.resources[resource].image = image;
+        graph.resources[resource].view = view;
+    }
+
+    uint32_t AddRenderGraphPass(RenderGraph& graph,
+        const std::string& name,
+        VkPipelineBindPoint bindPoint,
+        std::function<void(VkCommandBuffer)> record)
+    {
+        graph.passes.push_back(
+            {
+                name,
+                bindPoint,
+                {},
+                record,
+                false,
+                false,
+                0,
+                0
+            });
+        return static_cast<uint32_t>(graph.passes.size() - 1);
+    }
+
+    void UseRenderGraphResource(RenderGraph& graph,
+        uint32_t pass,
+        uint32_t resource,
+        RenderGraphUsage usage)
+    {
+        UseRenderGraphAttachment(graph, pass, resource, usage, VK_ATTACHMENT_LOAD_OP_LOAD, {});
+    }
+
+    void UseRenderGraphAttachment(RenderGraph& graph,
+        uint32_t pass,
+        uint32_t resource,
+        RenderGraphUsage usage,
+        VkAttachmentLoadOp loadOp,
+        VkClearValue clearValue)
+    {
+        graph.passes[pass].accesses.push_back({ resource, usage, loadOp, clearValue });
+        graph.resources[resource].usage |= GetRenderGraphImageUsage(usage);
+    }
+
+    void MarkRenderGraphPassSideEffect(RenderGraph& graph,
+        uint32_t pass)
+    {
+        graph.passes[pass].sideEffect = true;
+    }
+
+    static void CullRenderGraphPasses(RenderGraph& graph)
+    {
+        //walking backwards, a pass survives when it writes an imported resource or contents a later pass reads
+        std::vector<bool> needed(graph.resources.size(), false);
+        for (size_t i = graph.passes.size(); i-- > 0;)
+        {
+            RenderGraphPass& pass = graph.passes[i];
+            bool live = pass.sideEffect;
+            for (auto& access : pass.accesses)
+            {
+                if (IsWriteUsage(access.usage) && (graph.resources[access.resource].imported || needed[access.resource]))
+                {
+                    live = true;
+                }
+            }
+
+            pass.culled = !live;
+            if (!live)
+            {
+                continue;
+            }
+
+            for (auto& access : pass.accesses)
+            {
+                if (IsWriteUsage(access.usage) && access.loadOp != VK_ATTACHMENT_LOAD_OP_LOAD)
+                {
+                    needed[access.resource] = false;
+                }
+            }
+            for (auto& access : pass.accesses)
+            {
+                if (!IsWriteUsage(access.usage) || access.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+                {
+                    needed[access.resource] = true;
+                }
+            }
+        }
+    }
+
+    static void BuildRenderGraphSteps(RenderGraph& graph)
+    {
+        //consecutive graphics passes become subpasses of one render pass while they only exchange data through attachments
+        std::vector<bool> attachmentInStep(graph.resources.size(), false);
+        std::vector<bool> otherInStep(graph.resources.size(), false);
+        std::vector<bool> otherWriteInStep(graph.resources.size(), false);
+        VkExtent2D stepSize = {};
+        bool stepHasAttachments = false;
+
+        graph.steps.clear();
+        for (uint32_t i = 0; i < graph.passes.size(); i++)
+        {
+            RenderGraphPass& pass = graph.passes[i];
+            if (pass.culled)
+            {
+                continue;
+            }
+
+            VkExtent2D size;
+            bool hasAttachments = pass.bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS && GetRenderGraphPassExtent(graph, pass, size);
+
+            bool merge = hasAttachments && stepHasAttachments && !graph.steps.empty() &&
+                size.width == stepSize.width && size.height == stepSize.height;
+            for (auto& access : pass.accesses)
+            {
+                if (!merge)
+                {
+                    break;
+                }
+
+                uint32_t resource = access.resource;
+                if (IsAttachmentUsage(access.usage))
+                {
+                    merge = !otherInStep[resource];
+                }
+                else
+                {
+                    merge = !attachmentInStep[resource] && !otherWriteInStep[resource] &&
+                        (!IsWriteUsage(access.usage) || !otherInStep[resource]);
+                }
+            }
+
+            if (!merge)
+            {
+                graph.steps.push_back({});
+                graph.steps.back().renderPass = VK_NULL_HANDLE;
+                std::fill(attachmentInStep.begin(), attachmentInStep.end(), false);
+                std::fill(otherInStep.begin(), otherInStep.end(), false);
+                std::fill(otherWriteInStep.begin(), otherWriteInStep.end(), false);
+                stepHasAttachments = hasAttachments;
+                stepSize = hasAttachments ? size : VkExtent2D{};
+            }
+
+            RenderGraphStep& step = graph.steps.back();
+            pass.step = static_cast<uint32_t>(graph.steps.size() - 1);
+            pass.subpass = static_cast<uint32_t>(step.passes.size());
+            step.passes.push_back(i);
+            step.size = stepSize;
+
+            for (auto& access : pass.accesses)
+            {
+                if (IsAttachmentUsage(access.usage))
+                {
+                    attachmentInStep[access.resource] = true;
+                }
+                else
+                {
+                    otherInStep[access.resource] = true;
+                    otherWriteInStep[access.resource] = otherWriteInStep[access.resource] || IsWriteUsage(access.usage);
+                }
+
+                RenderGraphResource& resource = graph.resources[access.resource];
+                int32_t stepIndex = static_cast<int32_t>(pass.step);
+                resource.firstStep = resource.firstStep < 0 ? stepIndex : resource.firstStep;
+                resource.lastStep = stepIndex;
+            }
+        }
+    }
+
+    static bool CreateRenderGraphTransientImages(VkDevice device,
+        VkPhysicalDevice gpu,
+        RenderGraph& graph,
+        std::vector<std::vector<uint32_t>>& aliasGroups)
+    {
+        std::vector<uint32_t> transients;
+        for (uint32_t i = 0; i < graph.resources.size(); i++)
+        {
+            const RenderGraphResource& resource = graph.resources[i];
+            if (!resource.imported && resource.type == RENDER_GRAPH_RESOURCE_IMAGE && resource.firstStep >= 0)
+            {
+                transients.push_back(i);
+            }
+        }
+
+        std::sort(transients.begin(), transients.end(), [&](uint32_t a, uint32_t b)
+            {
+                return graph.resources[a].firstStep < graph.resources[b].firstStep;
+            });
+
+        //images whose step ranges do not overlap share memory, lazily allocated images only alias each other
+        aliasGroups.clear();
+        std::vector<bool> lazyGroups;
+        for (auto index : transients)
+        {
+            RenderGraphResource& resource = graph.resources[index];
+            resource.usage = GetTransientAttachmentUsage(gpu, resource.usage);
+            bool lazy = (resource.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0;
+
+            bool placed = false;
+            for (size_t group = 0; group < aliasGroups.size() && !placed; group++)
+            {
+                if (lazyGroups[group] == lazy && graph.resources[aliasGroups[group].back()].lastStep < resource.firstStep)
+                {
+                    aliasGroups[group].push_back(index);
+                    placed = true;
+                }
+            }
+
+            if (!placed)
+            {
+                aliasGroups.push_back({ index });
+                lazyGroups.push_back(lazy);
+            }
+        }
+
+        for (size_t group = 0; group < aliasGroups.size(); group++)
+        {
+            std::vector<VkImage> images;
+            for (auto index : aliasGroups[group])
+            {
+                RenderGraphResource& resource = graph.resources[index];
+                CreateImage(device, VK_IMAGE_TYPE_2D, resource.imageInfo.format,
+                    { resource.imageInfo.size.width, resource.imageInfo.size.height, 1 }, 1, 1,
+                    resource.imageInfo.samples, resource.usage, false, resource.image);
+                images.push_back(resource.image);
+            }
+
+            VkMemoryPropertyFlags memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            if (lazyGroups[group])
+            {
+                memoryProperties |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+            }
+
+            VkDeviceMemory memory;
+            if (!AllocateAndBindAliasedMemoryToImages(device, gpu, images, memoryProperties, memory))
+            {
+                return false;
+            }
+            graph.transientMemory.push_back(memory);
+
+            for (auto index : aliasGroups[group])
+            {
+                RenderGraphResource& resource = graph.resources[index];
+                CreateImageView(device, resource.image, VK_IMAGE_VIEW_TYPE_2D, resource.imageInfo.format,
+                    resource.imageInfo.aspect, resource.view);
+            }
+        }
+
+        return true;
+    }
+
+    static void AddRenderGraphBarrier(const RenderGraph& graph,
+        const RenderGraphResourceUse& use,
+        VkImageLayout oldLayout,
+        VkPipelineStageFlags srcStages,
+        VkAccessFlags srcAccess,
+        RenderGraphBarrier& barrier)
+    {
+        barrier.srcStages |= srcStages;
+        barrier.dstStages |= use.stages;
+
+        if (graph.resources[use.resource].type == RENDER_GRAPH_RESOURCE_IMAGE)
+        {
+            barrier.images.push_back({ use.resource, srcAccess, use.access, oldLayout, use.layout });
+        }
+        else
+        {
+            barrier.buffers.push_back({ use.resource, srcAccess, use.access });
+        }
+    }
+
+    static void CreateRenderGraphRenderPass(VkDevice device,
+        RenderGraph& graph,
+        uint32_t stepIndex,
+        std::vector<RenderGraphResourceState>& states)
+    {
+        RenderGraphStep& step = graph.steps[stepIndex];
+        step.attachments.clear();
+        step.clearValues.clear();
+
+        std::vector<VkAttachmentDescription> attachmentDescriptions;
+        std::vector<SubpassParams> subpassParams(step.passes.size());
+        std::vector<VkAttachmentReference> depthReferences(step.passes.size());
+        std::vector<VkSubpassDependency> subpassDependencies;
+        std::vector<std::vector<bool>> usedInSubpass(step.passes.size());
+        std::vector<RenderGraphResourceUse> uses;
+
+        std::vector<VkSubpassDependency> externalDependencies;
+        for (uint32_t subpass = 0; subpass < step.passes.size(); subpass++)
+        {
+            externalDependencies.push_back({ VK_SUBPASS_EXTERNAL, subpass, 0, 0, 0, 0, 0 });
+        }
+
+        for (uint32_t subpass = 0; subpass < step.passes.size(); subpass++)
+        {
+            RenderGraphPass& pass = graph.passes[step.passes[subpass]];
+            SubpassParams& params = subpassParams[subpass];
+            params.pipelineType = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            params.depthStencilAttachment = nullptr;
+
+            GetRenderGraphPassUses(graph, pass, uses);
+            for (auto& use : uses)
+            {
+                if (!use.attachment)
+                {
+                    continue;
+                }
+
+                const RenderGraphResource& resource = graph.resources[use.resource];
+                RenderGraphResourceState& state = states[use.resource];
+
+                auto found = std::find(step.attachments.begin(), step.attachments.end(), use.resource);
+                uint32_t attachment = static_cast<uint32_t>(found - step.attachments.begin());
+                bool renderPassTransition = false;
+                if (found == step.attachments.end())
+                {
+                    //the render pass performs the first transition, contents that are not loaded start undefined
+                    VkAttachmentLoadOp loadOp = use.usage == RENDER_GRAPH_USAGE_INPUT_ATTACHMENT ||
+                        use.usage == RENDER_GRAPH_USAGE_DEPTH_READ_ONLY_ATTACHMENT ? VK_ATTACHMENT_LOAD_OP_LOAD : use.loadOp;
+                    VkAttachmentStoreOp storeOp = resource.imported || resource.lastStep > static_cast<int32_t>(stepIndex) ?
+                        VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                    bool stencil = (resource.imageInfo.aspect & VK_IMAGE_ASPECT_STENCIL_BIT) != 0;
+
+                    attachmentDescriptions.push_back(
+                        {
+                            0,
+                            resource.imageInfo.format,
+                            resource.imageInfo.samples,
+                            loadOp,
+                            storeOp,
+                            stencil ? loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                            stencil ? storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                            loadOp == VK_ATTACHMENT_LOAD_OP_LOAD ? state.layout : VK_IMAGE_LAYOUT_UNDEFINED,
+                            use.layout
+                        });
+                    step.attachments.push_back(use.resource);
+                    step.clearValues.push_back(use.clearValue);
+                    state.lastSubpass = -1;
+
+                    //the render pass transition replaces an explicit one, only the stage ordering remains
+                    renderPassTransition = attachmentDescriptions.back().initialLayout != use.layout;
+                    state.layout = use.layout;
+                }
+
+                VkPipelineStageFlags srcStages;
+                VkAccessFlags srcAccess;
+                if (ComputeRenderGraphHazard(state, use, true, srcStages, srcAccess) && srcStages != 0)
+                {
+                    if (state.lastSubpass < 0)
+                    {
+                        VkSubpassDependency& externalDependency = externalDependencies[subpass];
+                        externalDependency.srcStageMask |= srcStages;
+                        externalDependency.dstStageMask |= use.stages;
+                        externalDependency.srcAccessMask |= srcAccess;
+                        externalDependency.dstAccessMask |= use.access;
+                    }
+                    else if (state.lastSubpass != static_cast<int32_t>(subpass))
+                    {
+                        subpassDependencies.push_back(
+                            {
+                                static_cast<uint32_t>(state.lastSubpass),
+                                subpass,
+                                srcStages,
+                                use.stages,
+                                srcAccess,
+                                use.access,
+                                VK_DEPENDENCY_BY_REGION_BIT
+                            });
+                    }
+                }
+                if (renderPassTransition && !use.write)
+                {
+                    state.transitionStages |= use.stages;
+                }
+                state.lastSubpass = static_cast<int32_t>(subpass);
+                attachmentDescriptions[attachment].finalLayout = use.layout;
+
+                VkAttachmentReference reference = { attachment, use.layout };
+                switch (use.usage)
+                {
+                case RENDER_GRAPH_USAGE_COLOR_ATTACHMENT:
+                    params.colorAttachments.push_back(reference);
+                    break;
+                case RENDER_GRAPH_USAGE_INPUT_ATTACHMENT:
+                    params.inputAttachments.push_back(reference);
+                    break;
+                default:
+                    depthReferences[subpass] = reference;
+                    params.depthStencilAttachment = &depthReferences[subpass];
+                    break;
+                }
+            }
+        }
+
+        //attachments used before and after a subpass that does not touch them have to be preserved
+        for (uint32_t subpass = 0; subpass < step.passes.size(); subpass++)
+        {
+            usedInSubpass[subpass].assign(step.attachments.size(), false);
+            GetRenderGraphPassUses(graph, graph.passes[step.passes[subpass]], uses);
+            for (auto& use : uses)
+            {
+                auto found = std::find(step.attachments.begin(), step.attachments.end(), use.resource);
+                if (use.attachment && found != step.attachments.end())
+                {
+                    usedInSubpass[subpass][found - step.attachments.begin()] = true;
+                }
+            }
+        }
+
+        for (uint32_t subpass = 1; subpass + 1 < step.passes.size(); subpass++)
+        {
+            for (uint32_t attachment = 0; attachment < step.attachments.size(); attachment++)
+            {
+                bool before = false;
+                bool after = false;
+                for (uint32_t other = 0; other < step.passes.size(); other++)
+                {
+                    before = before || (other < subpass && usedInSubpass[other][attachment]);
+                    after = after || (other > subpass && usedInSubpass[other][attachment]);
+                }
+
+                if (before && after && !usedInSubpass[subpass][attachment])
+                {
+                    subpassParams[subpass].preserveAttachments.push_back(attachment);
+                }
+            }
+        }
+
+        for (uint32_t attachment = 0; attachment < step.attachments.size(); attachment++)
+        {
+            const RenderGraphResource& resource = graph.resources[step.attachments[attachment]];
+            RenderGraphResourceState& state = states[step.attachments[attachment]];
+            if (resource.imported && resource.lastStep == static_cast<int32_t>(stepIndex) &&
+                resource.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED)
+            {
+                attachmentDescriptions[attachment].finalLayout = resource.finalLayout;
+            }
+            state.layout = attachmentDescriptions[attachment].finalLayout;
+            state.lastSubpass = -1;
+        }
+
+        for (auto& externalDependency : externalDependencies)
+        {
+            if (externalDependency.srcStageMask != 0)
+            {
+                subpassDependencies.push_back(externalDependency);
+            }
+        }
+
+        if (device != VK_NULL_HANDLE)
+        {
+            CreateRenderPass(device, attachmentDescriptions, subpassParams, subpassDependencies, step.renderPass);
+        }
+    }
+
+    static void SimulateRenderGraph(VkDevice device,
+        RenderGraph& graph,
+        std::vector<RenderGraphResourceState>& states)
+    {
+        std::vector<RenderGraphResourceUse> uses;
+        for (uint32_t stepIndex = 0; stepIndex < graph.steps.size(); stepIndex++)
+        {
+            RenderGraphStep& step = graph.steps[stepIndex];
+            step.barrier = {};
+
+            //everything a render pass does not cover is synchronized by one barrier in front of the step
+            for (auto passIndex : step.passes)
+            {
+                GetRenderGraphPassUses(graph, graph.passes[passIndex], uses);
+                for (auto& use : uses)
+                {
+                    if (use.attachment && step.size.width != 0)
+                    {
+                        continue;
+                    }
+
+                    bool image = graph.resources[use.resource].type == RENDER_GRAPH_RESOURCE_IMAGE;
+                    VkImageLayout oldLayout = states[use.resource].layout;
+                    VkPipelineStageFlags srcStages;
+                    VkAccessFlags srcAccess;
+                    if (ComputeRenderGraphHazard(states[use.resource], use, image, srcStages, srcAccess))
+                    {
+                        AddRenderGraphBarrier(graph, use, oldLayout, srcStages, srcAccess, step.barrier);
+                    }
+                }
+            }
+
+            if (step.size.width != 0)
+            {
+                CreateRenderGraphRenderPass(device, graph, stepIndex, states);
+            }
+        }
+
+        //imported images are handed back in the layout their owner expects
+        graph.finalBarrier = {};
+        for (uint32_t i = 0; i < graph.resources.size(); i++)
+        {
+            const RenderGraphResource& resource = graph.resources[i];
+            RenderGraphResourceState& state = states[i];
+            if (!resource.imported || resource.type != RENDER_GRAPH_RESOURCE_IMAGE ||
+                resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || state.layout == resource.finalLayout)
+            {
+                continue;
+            }
+
+            graph.finalBarrier.srcStages |= state.readStages != 0 ? state.readStages : state.writeStages;
+            graph.finalBarrier.dstStages |= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+            graph.finalBarrier.images.push_back({ i, state.readStages != 0 ? 0 : state.writeAccess, 0,
+                state.layout, resource.finalLayout });
+            state.layout = resource.finalLayout;
+        }
+    }
+
+    bool CompileRenderGraph(VkDevice device,
+        VkPhysicalDevice gpu,
+        RenderGraph& graph)
+    {
+        if (graph.compiled)
+        {
+            WARN_LOG("Render graph is already compiled");
+            return false;
+        }
+
+        for (auto& resource : graph.resources)
+        {
+            resource.firstStep = -1;
+            resource.lastStep = -1;
+            //the first use of an imported image waits for the work that handed it over
+            resource.initialState = { resource.initialLayout, resource.initialStages, resource.initialAccess, 0, 0, 0, -1 };
+        }
+
+        CullRenderGraphPasses(graph);
+        BuildRenderGraphSteps(graph);
+
+        std::vector<std::vector<uint32_t>> aliasGroups;
+        if (!CreateRenderGraphTransientImages(device, gpu, graph, aliasGroups))
+        {
+            return false;
+        }
+
+        //a dry run finds how every resource is left at the end of the frame
+        std::vector<RenderGraphResourceState> states;
+        for (auto& resource : graph.resources)
+        {
+            states.push_back(resource.initialState);
+        }
+        SimulateRenderGraph(VK_NULL_HANDLE, graph, states);
+
+        //transient images wait for the previous image in their memory, the first one for the last one of the previous frame
+        for (auto& group : aliasGroups)
+        {
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                const RenderGraphResourceState& previous = states[group[(i + group.size() - 1) % group.size()]];
+                RenderGraphResourceState& initialState = graph.resources[group[i]].initialState;
+                initialState.writeStages = previous.readStages | previous.writeStages | previous.transitionStages;
+                initialState.writeAccess = previous.writeAccess;
+            }
+        }
+
+        states.clear();
+        for (auto& resource : graph.resources)
+        {
+            states.push_back(resource.initialState);
+        }
+        SimulateRenderGraph(device, graph, states);
+
+        uint32_t culledCount = 0;
+        for (auto& pass : graph.passes)
+        {
+            culledCount += pass.culled ? 1 : 0;
+        }
+        INFO_LOG("Render graph compiled: " + std::to_string(graph.passes.size() - culledCount) + " passes in " +
+            std::to_string(graph.steps.size()) + " steps, " + std::to_string(culledCount) + " culled, " +
+            std::to_string(graph.transientMemory.size()) + " transient memory objects");
+
+        graph.compiled = true;
+        return true;
+    }
+
+    bool GetRenderGraphPassRenderPass(const RenderGraph& graph,
+        uint32_t pass,
+        VkRenderPass& renderPass,
+        uint32_t& subpass)
+    {
+        const RenderGraphPass& graphPass = graph.passes[pass];
+        if (!graph.compiled || graphPass.culled || graph.steps[graphPass.step].renderPass == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        renderPass = graph.steps[graphPass.step].renderPass;
+        subpass = graphPass.subpass;
+        return true;
+    }
+
+    static void RecordRenderGraphBarrier(VkCommandBuffer commandBuffer,
+        const RenderGraph& graph,
+        const RenderGraphBarrier& barrier)
+    {
+        //image and buffer dependencies of a step go out in a single pipeline barrier
+        BarrierBatch batch;
+        BeginBarrierBatch(commandBuffer, batch);
+
+        for (auto& image : barrier.images)
+        {
+            const RenderGraphResource& resource = graph.resources[image.resource];
+            AddImageBarrierToBatch(batch, barrier.srcStages, barrier.dstStages,
+                {
+                    resource.image,
+                    image.srcAccess,
+                    image.dstAccess,
+                    image.oldLayout,
+                    image.newLayout,
+                    VK_QUEUE_FAMILY_IGNORED,
+                    VK_QUEUE_FAMILY_IGNORED,
+                    resource.imageInfo.aspect
+                });
+        }
+
+        for (auto& buffer : barrier.buffers)
+        {
+            AddBufferBarrierToBatch(batch, barrier.srcStages, barrier.dstStages,
+                {
+                    graph.resources[buffer.resource].buffer,
+                    buffer.srcAccess,
+                    buffer.dstAccess,
+                    VK_QUEUE_FAMILY_IGNORED,
+                    VK_QUEUE_FAMILY_IGNORED
+                });
+        }
+
+        FlushBarrierBatch(batch);
+    }
+
+    void ExecuteRenderGraph(VkDevice device,
+        VkCommandBuffer commandBuffer,
+        RenderGraph& graph)
+    {
+        for (auto& step : graph.steps)
+        {
+            RecordRenderGraphBarrier(commandBuffer, graph, step.barrier);
+
+            if (step.renderPass == VK_NULL_HANDLE)
+            {
+                for (auto passIndex : step.passes)
+                {
+                    graph.passes[passIndex].record(commandBuffer);
+                }
+                continue;
+            }
+
+            //framebuffers are cached per set of views, imported swapchain views select one each frame,
+            //so a recreated swapchain needs a rebuilt graph
+            std::vector<VkImageView> views;
+            for (auto resource : step.attachments)
+            {
+                views.push_back(graph.resources[resource].view);
+            }
+
+            uint64_t key = HashBytes(views.data(), views.size() * sizeof(VkImageView));
+            auto framebuffer = step.framebuffers.find(key);
+            if (framebuffer == step.framebuffers.end())
+            {
+                VkFramebuffer newFramebuffer;
+                CreateFramebuffer(device, step.renderPass, views, step.size.width, step.size.height, 1, newFramebuffer);
+                framebuffer = step.framebuffers.insert({ key, newFramebuffer }).first;
+            }
+
+            BeginRenderPass(commandBuffer, step.renderPass, framebuffer->second, { { 0, 0 }, step.size },
+                step.clearValues, VK_SUBPASS_CONTENTS_INLINE);
+            for (size_t i = 0; i < step.passes.size(); i++)
+            {
+                if (i > 0)
+                {
+                    ProgressToTheNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+                }
+                graph.passes[step.passes[i]].record(commandBuffer);
+            }
+            EndRenderPass(commandBuffer);
+        }
+
+        RecordRenderGraphBarrier(commandBuffer, graph, graph.finalBarrier);
+    }
+
+    void DestroyRenderGraph(VkDevice device,
+        RenderGraph& graph)
+    {
+        for (auto& step : graph.steps)
+        {
+            for (auto& framebuffer : step.framebuffers)
+            {
+                DestroyFramebuffer(device, framebuffer.second);
+            }
+            if (step.renderPass != VK_NULL_HANDLE)
+            {
+                DestroyRenderPass(device, step.renderPass);
+            }
+        }
+
+        for (auto& resource : graph.resources)
+        {
+            if (resource.imported || resource.image == VK_NULL_HANDLE)
+            {
+                continue;
+            }
+
+            DestroyImageView(device, resource.view);
+            DestroyImage(device, resource.image);
+        }
+
+        for (auto& memory : graph.transientMemory)
+        {
+            FreeDeviceMemoryObject(device, memory);
+        }
+
+        graph.resources.clear();
+        graph.passes.clear();
+        graph.steps.clear();
+        graph.finalBarrier = {};
+        graph.transientMemory.clear();
+        graph.compiled = false;
+    }
+}
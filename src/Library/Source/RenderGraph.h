@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "Resources.h"
+#include "RenderPass.h"
+#include "BarrierBatch.h"
+#include "Library/Common/Tools.h"
+#include "Library/Structs/RenderGraph.h"
+
+namespace vk
+{
+    uint32_t AddRenderGraphImage(RenderGraph& graph,
+        const std::string& name,
+        const RenderGraphImageInfo& imageInfo);
+
+    uint32_t ImportRenderGraphImage(RenderGraph& graph,
+        const std::string& name,
+        const RenderGraphImageInfo& imageInfo,
+        VkImageLayout initialLayout,
+        VkPipelineStageFlags initialStages,
+        VkAccessFlags initialAccess,
+        VkImageLayout finalLayout);
+
+    uint32_t ImportRenderGraphBuffer(RenderGraph& graph,
+        const std::string& name,
+        VkBuffer buffer);
+
+    void SetRenderGraphImportedImage(RenderGraph& graph,
+        uint32_t resource,
+        VkImage image,
+        VkImageView view);
+
+    uint32_t AddRenderGraphPass(RenderGraph& graph,
+        const std::string& name,
+        VkPipelineBindPoint bindPoint,
+        std::function<void(VkCommandBuffer)> record);
+
+    void UseRenderGraphResource(RenderGraph& graph,
+        uint32_t pass,
+        uint32_t resource,
+        RenderGraphUsage usage);
+
+    void UseRenderGraphAttachment(RenderGraph& graph,
+        uint32_t pass,
+        uint32_t resource,
+        RenderGraphUsage usage,
+        VkAttachmentLoadOp loadOp,
+        VkClearValue clearValue);
+
+    void MarkRenderGraphPassSideEffect(RenderGraph& graph,
+        uint32_t pass);
+
+    bool CompileRenderGraph(VkDevice device,
+        VkPhysicalDevice gpu,
+        RenderGraph& graph);
+
+    bool GetRenderGraphPassRenderPass(const RenderGraph& graph,
+        uint32_t pass,
+        VkRenderPass& renderPass,
+        uint32_t& subpass);
+
+    void ExecuteRenderGraph(VkDevice device,
+        VkCommandBuffer commandBuffer,
+        RenderGraph& graph);
+
+    void DestroyRenderGraph(VkDevice device,
+        RenderGraph& graph);
+}
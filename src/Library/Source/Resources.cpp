@@ -1,4 +1,6 @@
 #include "Resources.h"
+#include "MappedBuffer.h"
+#include "MemoryTracker.h"
 
 namespace vk
 {
@@ -20,6 +22,7 @@ namespace vk
         };
 
         VK_CHECK_RESULT(vkCreateBuffer(device, &bufferInfo, nullptr, &buffer));
+        RegisterBufferMemoryCategory(buffer, usage);
     }
 
     void AllocateAndBindMemoryObjectToBuffer(VkDevice device,
@@ -50,6 +53,7 @@ namespace vk
                 VkResult res = vkAllocateMemory(device, &allocInfo, nullptr, &memoryObject);
                 if (res == VK_SUCCESS)
                 {
+                    TrackBufferMemoryAllocation(buffer, memoryObject, i, memoryRequirements.size);
                     break;
                 }
             }
@@ -64,6 +68,64 @@ namespace vk
         VK_CHECK_RESULT(vkBindBufferMemory(device, buffer, memoryObject, 0));
     }
 
+    VkMemoryPropertyFlags AllocateAndBindHostVisibleMemoryToBuffer(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkBuffer buffer,
+        bool preferDeviceLocal,
+        VkDeviceMemory& memoryObject)
+    {
+        VkPhysicalDeviceMemoryProperties physicalDeviceMemoryProperties;
+        vkGetPhysicalDeviceMemoryProperties(gpu, &physicalDeviceMemoryProperties);
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetBufferMemoryRequirements(device, buffer, &memoryRequirements);
+
+        //device local host visible memory (resizable bar, integrated gpus) saves the staging copy,
+        //coherent memory saves the flushes and cached memory is the last resort
+        std::vector<VkMemoryPropertyFlags> candidates;
+        if (preferDeviceLocal)
+        {
+            candidates.push_back(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            candidates.push_back(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+        }
+        candidates.push_back(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        candidates.push_back(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+        candidates.push_back(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+        memoryObject = VK_NULL_HANDLE;
+        for (auto& candidate : candidates)
+        {
+            for (uint32_t i = 0; i < physicalDeviceMemoryProperties.memoryTypeCount; i++)
+            {
+                VkMemoryPropertyFlags propertyFlags = physicalDeviceMemoryProperties.memoryTypes[i].propertyFlags;
+                if (!(memoryRequirements.memoryTypeBits & (1 << i)) || (propertyFlags & candidate) != candidate)
+                {
+                    continue;
+                }
+
+                VkMemoryAllocateInfo allocInfo =
+                {
+                    VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+                    nullptr,
+                    memoryRequirements.size,
+                    i
+                };
+
+                //the device local heap can be small, so a failure falls through to the next candidate
+                if (vkAllocateMemory(device, &allocInfo, nullptr, &memoryObject) == VK_SUCCESS)
+                {
+                    TrackBufferMemoryAllocation(buffer, memoryObject, i, memoryRequirements.size);
+                    VK_CHECK_RESULT(vkBindBufferMemory(device, buffer, memoryObject, 0));
+                    return propertyFlags;
+                }
+            }
+        }
+
+        WARN_LOG("Failed to create host visible memory object for buffer");
+        return 0;
+    }
+
     void SetBufferMemoryBarrier(VkCommandBuffer commandBuffer,
         VkPipelineStageFlags generatingStages,
         VkPipelineStageFlags consumingStages,
@@ -148,6 +210,7 @@ namespace vk
         };
 
         VK_CHECK_RESULT(vkCreateImage(device, &imageInfo, nullptr, &image));
+        RegisterImageMemoryCategory(image, usage);
     }
 
     void AllocateAndBindMemoryObjectToImage(VkDevice device,
@@ -178,6 +241,7 @@ namespace vk
                 VkResult res = vkAllocateMemory(device, &allocInfo, nullptr, &memoryObject);
                 if (res == VK_SUCCESS)
                 {
+                    TrackImageMemoryAllocation(image, memoryObject, i, memoryRequirements.size);
                     break;
                 }
             }
@@ -219,15 +283,15 @@ namespace vk
                     VK_REMAINING_ARRAY_LAYERS
                 }
             });
+        }
 
-            if (barriers.size() == 0)
-            {
-                return;
-            }
-
-            vkCmdPipelineBarrier(commandBuffer, generatingStages, consumingStages, 0, 0, nullptr, 0, nullptr,
-                static_cast<uint32_t>(barriers.size()), barriers.data());
+        if (barriers.size() == 0)
+        {
+            return;
         }
+
+        vkCmdPipelineBarrier(commandBuffer, generatingStages, consumingStages, 0, 0, nullptr, 0, nullptr,
+            static_cast<uint32_t>(barriers.size()), barriers.data());
     }
     void CreateImageView(VkDevice device, 
         VkImage image, 
@@ -280,6 +344,125 @@ namespace vk
         CreateImageView(device, image, VK_IMAGE_VIEW_TYPE_2D, format, aspect, imageView);
     }
 
+    bool IsLazilyAllocatedMemorySupported(VkPhysicalDevice gpu)
+    {
+        VkPhysicalDeviceMemoryProperties physicalDeviceMemoryProperties;
+        vkGetPhysicalDeviceMemoryProperties(gpu, &physicalDeviceMemoryProperties);
+
+        for (uint32_t i = 0; i < physicalDeviceMemoryProperties.memoryTypeCount; i++)
+        {
+            if (physicalDeviceMemoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    VkImageUsageFlags GetTransientAttachmentUsage(VkPhysicalDevice gpu,
+        VkImageUsageFlags usage)
+    {
+        //transient images can only be used as attachments, anything else keeps the usage unchanged
+        VkImageUsageFlags attachmentUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+            VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        if ((usage & ~attachmentUsage) != 0 || !IsLazilyAllocatedMemorySupported(gpu))
+        {
+            return usage;
+        }
+
+        return usage | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
+
+    void Create2DTransientAttachmentAndView(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkFormat format,
+        VkExtent2D size,
+        VkSampleCountFlagBits samples,
+        VkImageUsageFlags usage,
+        VkImageAspectFlags aspect,
+        VkImage& image,
+        VkDeviceMemory& imageMemory,
+        VkImageView& imageView)
+    {
+        //on tiled gpus lazily allocated memory is never backed while the attachment stays in tile memory
+        VkImageUsageFlags transientUsage = GetTransientAttachmentUsage(gpu, usage);
+        VkMemoryPropertyFlags memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        if (transientUsage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+        {
+            memoryProperties |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+        }
+
+        CreateImage(device, VK_IMAGE_TYPE_2D, format, { size.width, size.height, 1 }, 1, 1, samples, transientUsage, false, image);
+        imageMemory = VK_NULL_HANDLE;
+        AllocateAndBindMemoryObjectToImage(device, gpu, image, static_cast<VkMemoryPropertyFlagBits>(memoryProperties), imageMemory);
+        CreateImageView(device, image, VK_IMAGE_VIEW_TYPE_2D, format, aspect, imageView);
+    }
+
+    bool AllocateAndBindAliasedMemoryToImages(VkDevice device,
+        VkPhysicalDevice gpu,
+        const std::vector<VkImage>& images,
+        VkMemoryPropertyFlags memoryProperties,
+        VkDeviceMemory& memoryObject)
+    {
+        memoryObject = VK_NULL_HANDLE;
+        if (images.empty())
+        {
+            return false;
+        }
+
+        //the images share one allocation, so only images whose lifetimes never overlap may be passed together
+        VkMemoryRequirements aliasedRequirements = { 0, 1, ~0u };
+        for (auto& image : images)
+        {
+            VkMemoryRequirements memoryRequirements;
+            vkGetImageMemoryRequirements(device, image, &memoryRequirements);
+            if (memoryRequirements.size > aliasedRequirements.size)
+            {
+                aliasedRequirements.size = memoryRequirements.size;
+            }
+            if (memoryRequirements.alignment > aliasedRequirements.alignment)
+            {
+                aliasedRequirements.alignment = memoryRequirements.alignment;
+            }
+            aliasedRequirements.memoryTypeBits &= memoryRequirements.memoryTypeBits;
+        }
+
+        VkPhysicalDeviceMemoryProperties physicalDeviceMemoryProperties;
+        vkGetPhysicalDeviceMemoryProperties(gpu, &physicalDeviceMemoryProperties);
+
+        for (uint32_t i = 0; i < physicalDeviceMemoryProperties.memoryTypeCount && memoryObject == VK_NULL_HANDLE; i++)
+        {
+            if ((aliasedRequirements.memoryTypeBits & (1 << i)) &&
+                (physicalDeviceMemoryProperties.memoryTypes[i].propertyFlags & memoryProperties) == memoryProperties)
+            {
+                VkMemoryAllocateInfo allocInfo =
+                {
+                    VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+                    nullptr,
+                    aliasedRequirements.size,
+                    i
+                };
+
+                if (vkAllocateMemory(device, &allocInfo, nullptr, &memoryObject) == VK_SUCCESS)
+                {
+                    TrackImageMemoryAllocation(images.front(), memoryObject, i, aliasedRequirements.size);
+                }
+            }
+        }
+
+        if (memoryObject == VK_NULL_HANDLE)
+        {
+            WARN_LOG("Failed to create aliased memory object for " + std::to_string(images.size()) + " images");
+            return false;
+        }
+
+        for (auto& image : images)
+        {
+            VK_CHECK_RESULT(vkBindImageMemory(device, image, memoryObject, 0));
+        }
+        return true;
+    }
+
     void CreateLayered2DImageWithCubemapView(VkDevice device, 
         VkPhysicalDevice gpu, 
         uint32_t size, 
@@ -389,12 +572,13 @@ namespace vk
         VkCommandBuffer commandBuffer, 
         std::vector<VkSemaphore> signalSemaphores)
     {
-        VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
-        CreateBuffer(device, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, stagingBuffer);
-        AllocateAndBindMemoryObjectToBuffer(device, gpu, stagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, stagingBufferMemory);
+        MappedBuffer stagingBuffer;
+        if (!CreateMappedBuffer(device, gpu, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, false, stagingBuffer))
+        {
+            return false;
+        }
 
-        MapUpdateAndUnmapHostVisibleMemory(device, stagingBufferMemory, 0, dataSize, data, true, nullptr);
+        WriteMappedBuffer(device, stagingBuffer, 0, data, dataSize);
 
         BeginCommandBufferRecordingOperation(commandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr);
 
@@ -410,7 +594,7 @@ namespace vk
         copy.dstOffset = dstOffset;
         copy.srcOffset = 0;
         copy.size = dataSize;
-        CopyDataBetweenBuffers(commandBuffer, stagingBuffer, dstBuffer, { copy });
+        CopyDataBetweenBuffers(commandBuffer, stagingBuffer.buffer, dstBuffer, { copy });
 
         transition.buffer = dstBuffer;
         transition.srcFlags = VK_ACCESS_TRANSFER_WRITE_BIT;
@@ -432,8 +616,7 @@ namespace vk
             return false;
         }
 
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
-        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        DestroyMappedBuffer(device, stagingBuffer);
 
         return true;
     }
@@ -457,12 +640,13 @@ namespace vk
         VkCommandBuffer commandBuffer, 
         std::vector<VkSemaphore> signalSemaphores)
     {
-        VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
-        CreateBuffer(device, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, stagingBuffer);
-        AllocateAndBindMemoryObjectToBuffer(device, gpu, stagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, stagingBufferMemory);
+        MappedBuffer stagingBuffer;
+        if (!CreateMappedBuffer(device, gpu, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, false, stagingBuffer))
+        {
+            return false;
+        }
 
-        MapUpdateAndUnmapHostVisibleMemory(device, stagingBufferMemory, 0, dataSize, data, true, nullptr);
+        WriteMappedBuffer(device, stagingBuffer, 0, data, dataSize);
 
         BeginCommandBufferRecordingOperation(commandBuffer, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr);
 
@@ -484,7 +668,7 @@ namespace vk
         copy.imageExtent = dstImageSize;
         copy.imageOffset = dstImageOffset;
         copy.imageSubresource = dstImageSubresources;
-        CopyDataFromBufferToImage(commandBuffer, stagingBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, { copy });
+        CopyDataFromBufferToImage(commandBuffer, stagingBuffer.buffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, { copy });
 
         transition.image = dstImage;
         transition.aspect = aspect;
@@ -509,8 +693,7 @@ namespace vk
             return false;
         }
 
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
-        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        DestroyMappedBuffer(device, stagingBuffer);
 
         return true;
     }
@@ -524,6 +707,7 @@ namespace vk
     void DestroyImage(VkDevice device, 
         VkImage& image)
     {
+        UnregisterImageMemoryCategory(image);
         vkDestroyImage(device, image, nullptr);
     }
 
@@ -536,12 +720,14 @@ namespace vk
     void DestroyBuffer(VkDevice device, 
         VkBuffer& buffer)
     {
+        UnregisterBufferMemoryCategory(buffer);
         vkDestroyBuffer(device, buffer, nullptr);
     }
 
     void FreeDeviceMemoryObject(VkDevice device, 
         VkDeviceMemory& deviceMemory)
     {
+        UntrackMemoryAllocation(deviceMemory);
         vkFreeMemory(device, deviceMemory, nullptr);
     }
 }
\ No newline at end of file
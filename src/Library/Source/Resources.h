@@ -21,6 +21,12 @@ namespace vk
         VkMemoryPropertyFlagBits memoryProperties,
         VkDeviceMemory& memoryObject);
 
+    VkMemoryPropertyFlags AllocateAndBindHostVisibleMemoryToBuffer(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkBuffer buffer,
+        bool preferDeviceLocal,
+        VkDeviceMemory& memoryObject);
+
     void SetBufferMemoryBarrier(VkCommandBuffer commandBuffer,
         VkPipelineStageFlags generatingStages,
         VkPipelineStageFlags consumingStages,
@@ -75,6 +81,28 @@ namespace vk
         VkDeviceMemory& imageMemory,
         VkImageView& imageView);
 
+    bool IsLazilyAllocatedMemorySupported(VkPhysicalDevice gpu);
+
+    VkImageUsageFlags GetTransientAttachmentUsage(VkPhysicalDevice gpu,
+        VkImageUsageFlags usage);
+
+    void Create2DTransientAttachmentAndView(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkFormat format,
+        VkExtent2D size,
+        VkSampleCountFlagBits samples,
+        VkImageUsageFlags usage,
+        VkImageAspectFlags aspect,
+        VkImage& image,
+        VkDeviceMemory& imageMemory,
+        VkImageView& imageView);
+
+    bool AllocateAndBindAliasedMemoryToImages(VkDevice device,
+        VkPhysicalDevice gpu,
+        const std::vector<VkImage>& images,
+        VkMemoryPropertyFlags memoryProperties,
+        VkDeviceMemory& memoryObject);
+
     void CreateLayered2DImageWithCubemapView(VkDevice device,
         VkPhysicalDevice gpu, 
         uint32_t size,
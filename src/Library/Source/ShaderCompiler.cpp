@@ -0,0 +1,204 @@
+#include "ShaderCompiler.h"
+
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+
+#ifdef VK_RUNTIME_SHADER_COMPILATION
+#include <shaderc/shaderc.hpp>
+#endif
+
+namespace vk
+{
+    //bump when compiler options change so that stale cache entries are not reused
+    static const uint64_t spirvCacheVersion = 1;
+
+    bool IsRuntimeShaderCompilationAvailable()
+    {
+#ifdef VK_RUNTIME_SHADER_COMPILATION
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::string GetShaderSourceDirectory()
+    {
+#ifdef VK_SHADER_SOURCE_DIRECTORY
+        return VK_SHADER_SOURCE_DIRECTORY;
+#else
+        return "shaders";
+#endif
+    }
+
+    bool CompileGlslToSpirv(std::string const& sourceFile,
+        const std::vector<unsigned char>& sourceCode,
+        VkShaderStageFlagBits stage,
+        const std::vector<ShaderDefine>& defines,
+        std::vector<unsigned char>& spirv)
+    {
+#ifdef VK_RUNTIME_SHADER_COMPILATION
+        shaderc_shader_kind kind;
+        switch (stage)
+        {
+        case VK_SHADER_STAGE_VERTEX_BIT:
+            kind = shaderc_vertex_shader;
+            break;
+        case VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT:
+            kind = shaderc_tess_control_shader;
+            break;
+        case VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT:
+            kind = shaderc_tess_evaluation_shader;
+            break;
+        case VK_SHADER_STAGE_GEOMETRY_BIT:
+            kind = shaderc_geometry_shader;
+            break;
+        case VK_SHADER_STAGE_FRAGMENT_BIT:
+            kind = shaderc_fragment_shader;
+            break;
+        case VK_SHADER_STAGE_COMPUTE_BIT:
+            kind = shaderc_compute_shader;
+            break;
+        default:
+            WARN_LOG("Unsupported shader stage for runtime compilation: " + sourceFile);
+            return false;
+        }
+
+        shaderc::CompileOptions options;
+        options.SetOptimizationLevel(shaderc_optimization_level_performance);
+        for (auto& define : defines)
+        {
+            options.AddMacroDefinition(define.name, define.value);
+        }
+
+        shaderc::Compiler compiler;
+        shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(
+            reinterpret_cast<const char*>(sourceCode.data()), sourceCode.size(), kind, sourceFile.c_str(), options);
+
+        if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+        {
+            ERROR_LOG("Failed to compile '" + sourceFile + "': " + result.GetErrorMessage());
+            return false;
+        }
+
+        spirv.assign(reinterpret_cast<const unsigned char*>(result.cbegin()),
+            reinterpret_cast<const unsigned char*>(result.cend()));
+        return true;
+#else
+        WARN_LOG("Runtime shader compilation is disabled, could not compile '" + sourceFile + "'");
+        return false;
+#endif
+    }
+
+    uint64_t GetShaderSourceKey(const std::vector<unsigned char>& sourceCode,
+        VkShaderStageFlagBits stage,
+        const std::vector<ShaderDefine>& defines)
+    {
+        uint64_t key = HashValue(spirvCacheVersion, 14695981039346656037ull);
+        key = HashValue(stage, key);
+        key = HashBytes(sourceCode.data(), sourceCode.size(), key);
+
+        for (auto& define : defines)
+        {
+            key = HashBytes(define.name.data(), define.name.size(), key);
+            key = HashBytes("=", 1, key);
+            key = HashBytes(define.value.data(), define.value.size(), key);
+            key = HashBytes(";", 1, key);
+        }
+
+        return key;
+    }
+
+    std::string GetSpirvCacheFilename(std::string const& cacheDirectory,
+        uint64_t sourceKey)
+    {
+        std::stringstream filename;
+        filename << cacheDirectory << "/" << std::hex << std::setw(16) << std::setfill('0') << sourceKey << ".spv";
+        return filename.str();
+    }
+
+    //a module starts with the magic number and a header of five words, and its size is a multiple of a word
+    static bool IsSpirvModule(const unsigned char* data,
+        size_t size)
+    {
+        if (size < 5 * sizeof(uint32_t) || size % sizeof(uint32_t) != 0)
+        {
+            return false;
+        }
+
+        uint32_t magic;
+        std::memcpy(&magic, data, sizeof(magic));
+        return magic == 0x07230203;
+    }
+
+    bool LoadShaderModuleFromSource(VkDevice device,
+        std::string const& sourceFile,
+        VkShaderStageFlagBits stage,
+        const std::vector<ShaderDefine>& defines,
+        std::string const& cacheDirectory,
+        std::string const& precompiledSpirvFile,
+        VkShaderModule& shaderModule)
+    {
+        std::vector<unsigned char> sourceCode;
+        if (GetBinaryFileContents(sourceFile, sourceCode))
+        {
+            std::string cacheFilename = GetSpirvCacheFilename(cacheDirectory,
+                GetShaderSourceKey(sourceCode, stage, defines));
+
+            //cache hit, source and defines did not change since the last compilation, a truncated or corrupt
+            //entry is compiled again and overwritten
+            MappedFile cachedSpirv;
+            if (MapFileContents(cacheFilename, cachedSpirv))
+            {
+                bool valid = IsSpirvModule(cachedSpirv.data, cachedSpirv.size);
+                if (valid)
+                {
+                    CreateShaderModule(device, cachedSpirv.data, cachedSpirv.size, shaderModule);
+                }
+                UnmapFileContents(cachedSpirv);
+
+                if (valid)
+                {
+                    return true;
+                }
+                WARN_LOG("Ignoring invalid cached SPIR-V '" + cacheFilename + "'");
+            }
+
+            std::vector<unsigned char> spirv;
+            if (IsRuntimeShaderCompilationAvailable() &&
+                CompileGlslToSpirv(sourceFile, sourceCode, stage, defines, spirv))
+            {
+                //a failed cache write only costs a compilation next time
+                std::error_code error;
+                std::filesystem::create_directories(cacheDirectory, error);
+                if (!WriteBinaryFileContents(cacheFilename, spirv))
+                {
+                    WARN_LOG("Could not cache SPIR-V of '" + sourceFile + "'");
+                }
+
+                CreateShaderModule(device, spirv, shaderModule);
+                return true;
+            }
+        }
+
+        if (precompiledSpirvFile.empty())
+        {
+            return false;
+        }
+
+        std::vector<unsigned char> spirv;
+        if (!GetBinaryFileContents(precompiledSpirvFile, spirv))
+        {
+            return false;
+        }
+
+        if (!IsSpirvModule(spirv.data(), spirv.size()))
+        {
+            WARN_LOG("'" + precompiledSpirvFile + "' is not a SPIR-V module");
+            return false;
+        }
+
+        CreateShaderModule(device, spirv, shaderModule);
+        return true;
+    }
+}
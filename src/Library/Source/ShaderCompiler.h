@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "LogicalDevice.h"
+#include "Pipeline.h"
+#include "Library/Structs/Pipeline.h"
+#include "Library/Common/Tools.h"
+
+namespace vk
+{
+    bool IsRuntimeShaderCompilationAvailable();
+
+    std::string GetShaderSourceDirectory();
+
+    bool CompileGlslToSpirv(std::string const& sourceFile,
+        const std::vector<unsigned char>& sourceCode,
+        VkShaderStageFlagBits stage,
+        const std::vector<ShaderDefine>& defines,
+        std::vector<unsigned char>& spirv);
+
+    uint64_t GetShaderSourceKey(const std::vector<unsigned char>& sourceCode,
+        VkShaderStageFlagBits stage,
+        const std::vector<ShaderDefine>& defines);
+
+    std::string GetSpirvCacheFilename(std::string const& cacheDirectory,
+        uint64_t sourceKey);
+
+    bool LoadShaderModuleFromSource(VkDevice device,
+        std::string const& sourceFile,
+        VkShaderStageFlagBits stage,
+        const std::vector<ShaderDefine>& defines,
+        std::string const& cacheDirectory,
+        std::string const& precompiledSpirvFile,
+        VkShaderModule& shaderModule);
+}
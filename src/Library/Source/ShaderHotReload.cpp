@@ -0,0 +1,298 @@
+#include "ShaderHotReload.h"
+
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace vk
+{
+    static const int watchIntervalMs = 250;
+
+    static void ReloadShader(ShaderHotReload& hotReload,
+        size_t shaderIndex)
+    {
+        WatchedShader& shader = hotReload.shaders[shaderIndex];
+        VkShaderModule shaderModule;
+        if (!LoadShaderModuleFromSource(hotReload.device, shader.sourceFile, shader.stage, shader.defines,
+            hotReload.cacheDirectory, "", shaderModule))
+        {
+            WARN_LOG("Hot reload of '" + shader.sourceFile + "' failed, keeping the previous pipeline");
+            return;
+        }
+
+        //the other stages are rebuilt from their latest modules, which the render thread may not have swapped in yet
+        WatchedProgram& program = hotReload.programs[shader.program];
+        std::vector<VkShaderModule> modules;
+        for (size_t index : program.shaders)
+        {
+            modules.push_back(index == shaderIndex ? shaderModule : hotReload.shaders[index].latestModule);
+        }
+
+        std::vector<RegisteredPipeline> pipelines;
+        if (!program.rebuildPipelines(modules, pipelines) || pipelines.size() != program.pipelines.size())
+        {
+            for (auto& pipeline : pipelines)
+            {
+                DestroyPipeline(hotReload.device, pipeline.pipeline);
+            }
+            DestroyShaderModule(hotReload.device, shaderModule);
+            WARN_LOG("Could not rebuild pipelines for '" + shader.sourceFile + "'");
+            return;
+        }
+        shader.latestModule = shaderModule;
+
+        std::lock_guard<std::mutex> lock(hotReload.mutex);
+        hotReload.pendingModules.push_back({ shader.module, shaderModule });
+        for (size_t i = 0; i < pipelines.size(); i++)
+        {
+            hotReload.pendingSwaps.push_back({ program.pipelines[i], pipelines[i] });
+        }
+        INFO_LOG("Reloaded '" + shader.sourceFile + "'");
+    }
+
+    static void PollShaderModificationTimes(ShaderHotReload& hotReload)
+    {
+        for (size_t i = 0; i < hotReload.shaders.size(); i++)
+        {
+            WatchedShader& shader = hotReload.shaders[i];
+            std::error_code error;
+            auto writeTime = std::filesystem::last_write_time(shader.sourceFile, error);
+            if (error || writeTime == shader.lastWriteTime)
+            {
+                continue;
+            }
+
+            shader.lastWriteTime = writeTime;
+            ReloadShader(hotReload, i);
+        }
+    }
+
+#ifdef __linux__
+    static bool WatchShadersWithInotify(ShaderHotReload& hotReload)
+    {
+        int handle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (handle < 0)
+        {
+            return false;
+        }
+
+        //editors usually save through a rename, so watch the directories instead of the files
+        std::unordered_map<int, std::filesystem::path> directories;
+        for (auto& shader : hotReload.shaders)
+        {
+            std::filesystem::path directory = std::filesystem::path(shader.sourceFile).parent_path();
+            if (directory.empty())
+            {
+                directory = ".";
+            }
+
+            int watch = inotify_add_watch(handle, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (watch < 0)
+            {
+                close(handle);
+                return false;
+            }
+            directories[watch] = directory;
+        }
+
+        alignas(inotify_event) char buffer[4096];
+        while (hotReload.running)
+        {
+            pollfd descriptor = { handle, POLLIN, 0 };
+            if (poll(&descriptor, 1, watchIntervalMs) <= 0)
+            {
+                continue;
+            }
+
+            ssize_t length = read(handle, buffer, sizeof(buffer));
+            if (length <= 0)
+            {
+                continue;
+            }
+
+            std::unordered_set<size_t> changedShaders;
+            for (char* pointer = buffer; pointer < buffer + length;)
+            {
+                inotify_event* event = reinterpret_cast<inotify_event*>(pointer);
+                pointer += sizeof(inotify_event) + event->len;
+
+                if (event->len == 0 || directories.find(event->wd) == directories.end())
+                {
+                    continue;
+                }
+
+                std::filesystem::path changedFile = (directories[event->wd] / event->name).lexically_normal();
+                for (size_t i = 0; i < hotReload.shaders.size(); i++)
+                {
+                    if (std::filesystem::path(hotReload.shaders[i].sourceFile).lexically_normal() == changedFile)
+                    {
+                        changedShaders.insert(i);
+                    }
+                }
+            }
+
+            for (size_t index : changedShaders)
+            {
+                ReloadShader(hotReload, index);
+            }
+        }
+
+        close(handle);
+        return true;
+    }
+#endif
+
+    static void WatchShaders(ShaderHotReload* hotReload)
+    {
+#ifdef __linux__
+        if (WatchShadersWithInotify(*hotReload))
+        {
+            return;
+        }
+        WARN_LOG("inotify is not available, falling back to polling shader files");
+#endif
+        while (hotReload->running)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(watchIntervalMs));
+            PollShaderModificationTimes(*hotReload);
+        }
+    }
+
+    uint32_t AddShaderHotReloadProgram(ShaderHotReload& hotReload,
+        std::function<bool(const std::vector<VkShaderModule>&, std::vector<RegisteredPipeline>&)> rebuildPipelines,
+        const std::vector<VkPipeline*>& pipelines)
+    {
+        hotReload.programs.push_back({ rebuildPipelines, pipelines, {} });
+        return static_cast<uint32_t>(hotReload.programs.size() - 1);
+    }
+
+    void WatchShaderForHotReload(ShaderHotReload& hotReload,
+        uint32_t program,
+        std::string const& sourceFile,
+        VkShaderStageFlagBits stage,
+        const std::vector<ShaderDefine>& defines,
+        VkShaderModule* module)
+    {
+        std::error_code error;
+        auto writeTime = std::filesystem::last_write_time(sourceFile, error);
+
+        //modules are passed to the rebuild callback in the order their shaders were watched
+        hotReload.programs[program].shaders.push_back(hotReload.shaders.size());
+        hotReload.shaders.push_back(
+            {
+                sourceFile,
+                stage,
+                defines,
+                program,
+                module,
+                *module,
+                writeTime
+            });
+    }
+
+    bool StartShaderHotReload(VkDevice device,
+        PipelineRegistry* registry,
+        std::string const& cacheDirectory,
+        ShaderHotReload& hotReload)
+    {
+        hotReload.device = device;
+        hotReload.registry = registry;
+        hotReload.cacheDirectory = cacheDirectory;
+        hotReload.running = false;
+
+        if (!IsRuntimeShaderCompilationAvailable())
+        {
+            WARN_LOG("Shader hot reload requires runtime shader compilation");
+            return false;
+        }
+
+        hotReload.running = true;
+        hotReload.worker = std::thread(WatchShaders, &hotReload);
+        return true;
+    }
+
+    void ApplyShaderHotReload(const FrameScheduler& scheduler,
+        ShaderHotReload& hotReload)
+    {
+        //a retired pipeline may still be referenced by any submission up to the value recorded when it was retired
+        auto retired = hotReload.retiredPipelines.begin();
+        while (retired != hotReload.retiredPipelines.end())
+        {
+            if (IsFrameSchedulerValueComplete(hotReload.device, scheduler, retired->retireValue))
+            {
+                DestroyPipeline(hotReload.device, retired->pipeline);
+                retired = hotReload.retiredPipelines.erase(retired);
+            }
+            else
+            {
+                retired++;
+            }
+        }
+
+        std::vector<ShaderModuleSwap> modules;
+        std::vector<PipelineSwap> swaps;
+        {
+            std::lock_guard<std::mutex> lock(hotReload.mutex);
+            modules.swap(hotReload.pendingModules);
+            swaps.swap(hotReload.pendingSwaps);
+        }
+
+        //pipelines do not reference their modules once created, and the watcher only builds from the latest ones
+        for (auto& swap : modules)
+        {
+            DestroyShaderModule(hotReload.device, *swap.target);
+            *swap.target = swap.module;
+        }
+
+        uint64_t retireValue = GetFrameSchedulerRetireValue(scheduler);
+        for (auto& swap : swaps)
+        {
+            VkPipeline oldPipeline = *swap.target;
+            *swap.target = swap.pipeline.pipeline;
+
+            if (hotReload.registry != nullptr)
+            {
+                VkPipeline displacedPipeline = ReplacePipelineInRegistry(*hotReload.registry, oldPipeline, swap.pipeline);
+                if (displacedPipeline != VK_NULL_HANDLE)
+                {
+                    hotReload.retiredPipelines.push_back({ displacedPipeline, retireValue });
+                }
+            }
+
+            hotReload.retiredPipelines.push_back({ oldPipeline, retireValue });
+        }
+    }
+
+    void StopShaderHotReload(ShaderHotReload& hotReload)
+    {
+        hotReload.running = false;
+        if (hotReload.worker.joinable())
+        {
+            hotReload.worker.join();
+        }
+
+        for (auto& retired : hotReload.retiredPipelines)
+        {
+            DestroyPipeline(hotReload.device, retired.pipeline);
+        }
+        hotReload.retiredPipelines.clear();
+
+        for (auto& swap : hotReload.pendingSwaps)
+        {
+            DestroyPipeline(hotReload.device, swap.pipeline.pipeline);
+        }
+        hotReload.pendingSwaps.clear();
+
+        for (auto& swap : hotReload.pendingModules)
+        {
+            DestroyShaderModule(hotReload.device, swap.module);
+        }
+        hotReload.pendingModules.clear();
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "LogicalDevice.h"
+#include "Pipeline.h"
+#include "PipelineRegistry.h"
+#include "ShaderCompiler.h"
+#include "FrameScheduler.h"
+#include "Library/Structs/ShaderHotReload.h"
+
+namespace vk
+{
+    uint32_t AddShaderHotReloadProgram(ShaderHotReload& hotReload,
+        std::function<bool(const std::vector<VkShaderModule>&, std::vector<RegisteredPipeline>&)> rebuildPipelines,
+        const std::vector<VkPipeline*>& pipelines);
+
+    void WatchShaderForHotReload(ShaderHotReload& hotReload,
+        uint32_t program,
+        std::string const& sourceFile,
+        VkShaderStageFlagBits stage,
+        const std::vector<ShaderDefine>& defines,
+        VkShaderModule* module);
+
+    bool StartShaderHotReload(VkDevice device,
+        PipelineRegistry* registry,
+        std::string const& cacheDirectory,
+        ShaderHotReload& hotReload);
+
+    void ApplyShaderHotReload(const FrameScheduler& scheduler,
+        ShaderHotReload& hotReload);
+
+    void StopShaderHotReload(ShaderHotReload& hotReload);
+}
@@ -357,8 +357,17 @@ namespace vk
         VkFence fence, 
         uint32_t& imageIndex)
     {
-        VK_CHECK_RESULT(vkAcquireNextImageKHR(device, swapchain, 2000000000, semaphore, fence, &imageIndex));
-        return true;
+        //a suboptimal image is still acquired and signals the semaphore, out of date or lost ones signal nothing
+        VkResult result = vkAcquireNextImageKHR(device, swapchain, 2000000000, semaphore, fence, &imageIndex);
+        switch (result)
+        {
+        case VK_SUCCESS:
+        case VK_SUBOPTIMAL_KHR:
+            return true;
+        default:
+            WARN_LOG("Could not acquire a swapchain image");
+            return false;
+        }
     }
 
     bool PresentImage(VkQueue queue, 
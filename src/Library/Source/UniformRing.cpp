@@ -0,0 +1,75 @@
+#include "UniformRing.h"
+
+#include <cstring>
+
+namespace vk
+{
+    static VkDeviceSize AlignUp(VkDeviceSize value,
+        VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool CreateUniformRing(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkDeviceSize frameSize,
+        uint32_t framesCount,
+        UniformRing& ring)
+    {
+        VkPhysicalDeviceFeatures features;
+        VkPhysicalDeviceProperties properties;
+        GetFeaturesAndPropertiesOfPhysicalDevice(gpu, features, properties);
+
+        //dynamic offsets have to be multiples of this alignment
+        ring.alignment = properties.limits.minUniformBufferOffsetAlignment;
+        ring.frameSize = AlignUp(frameSize, ring.alignment);
+        ring.framesCount = framesCount;
+        ring.frameIndex = 0;
+        ring.frameOffset = 0;
+
+        //uniforms are read once per draw, so device local host visible memory is preferred
+        return CreateMappedBuffer(device, gpu, ring.frameSize * framesCount, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+            true, ring.storage);
+    }
+
+    void BeginUniformRingFrame(UniformRing& ring,
+        uint32_t frameIndex)
+    {
+        //the region follows the frame scheduler, whose wait guarantees the gpu no longer reads it
+        ring.frameIndex = frameIndex % ring.framesCount;
+        ring.frameOffset = 0;
+    }
+
+    bool PushUniformData(UniformRing& ring,
+        const void* data,
+        VkDeviceSize size,
+        uint32_t& dynamicOffset)
+    {
+        VkDeviceSize offset = AlignUp(ring.frameOffset, ring.alignment);
+        if (offset + size > ring.frameSize)
+        {
+            WARN_LOG("Uniform ring frame region is full");
+            return false;
+        }
+
+        VkDeviceSize ringOffset = ring.frameIndex * ring.frameSize + offset;
+        std::memcpy(ring.storage.mappedData + ringOffset, data, static_cast<size_t>(size));
+
+        ring.frameOffset = offset + size;
+        dynamicOffset = static_cast<uint32_t>(ringOffset);
+        return true;
+    }
+
+    void FlushUniformRingFrame(VkDevice device,
+        const UniformRing& ring)
+    {
+        //one flush covers everything pushed this frame, it is skipped for coherent memory
+        FlushMappedBuffer(device, ring.storage, ring.frameIndex * ring.frameSize, ring.frameOffset);
+    }
+
+    void DestroyUniformRing(VkDevice device,
+        UniformRing& ring)
+    {
+        DestroyMappedBuffer(device, ring.storage);
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Library/Core/Core.h"
+#include "PhysicalDevice.h"
+#include "MappedBuffer.h"
+#include "Library/Structs/Buffer.h"
+
+namespace vk
+{
+    bool CreateUniformRing(VkDevice device,
+        VkPhysicalDevice gpu,
+        VkDeviceSize frameSize,
+        uint32_t framesCount,
+        UniformRing& ring);
+
+    void BeginUniformRingFrame(UniformRing& ring,
+        uint32_t frameIndex);
+
+    bool PushUniformData(UniformRing& ring,
+        const void* data,
+        VkDeviceSize size,
+        uint32_t& dynamicOffset);
+
+    void FlushUniformRingFrame(VkDevice device,
+        const UniformRing& ring);
+
+    void DestroyUniformRing(VkDevice device,
+        UniformRing& ring);
+}
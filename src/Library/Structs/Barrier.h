@@ -0,0 +1,17 @@
+#pragma once
+
+#include <vector>
+#include "vulkan/vulkan.h"
+
+namespace vk
+{
+    struct BarrierBatch
+    {
+        VkCommandBuffer commandBuffer;
+        VkPipelineStageFlags srcStages;
+        VkPipelineStageFlags dstStages;
+        std::vector<VkMemoryBarrier> memoryBarriers;
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+    };
+}
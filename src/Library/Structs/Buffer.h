@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <vector>
 #include "vulkan/vulkan.h"
 #include "glm/glm.hpp"
 
@@ -35,6 +37,43 @@ namespace vk
         uint32_t dstQueueFamilyIndex;
     };
 
+    struct MappedBuffer
+    {
+        VkBuffer buffer;
+        VkDeviceMemory memory;
+        unsigned char* mappedData;
+        VkDeviceSize size;
+        VkDeviceSize memorySize;
+        VkMemoryPropertyFlags memoryProperties;
+        VkDeviceSize nonCoherentAtomSize;
+    };
+
+    struct UniformRing
+    {
+        MappedBuffer storage;
+        VkDeviceSize alignment;
+        VkDeviceSize frameSize;
+        uint32_t framesCount;
+        uint32_t frameIndex;
+        VkDeviceSize frameOffset;
+    };
+
+    struct LinearAllocation
+    {
+        void* data;
+        VkBuffer buffer;
+        VkDeviceSize offset;
+    };
+
+    struct LinearAllocator
+    {
+        MappedBuffer storage;
+        VkDeviceSize frameSize;
+        uint32_t framesCount;
+        uint32_t frameIndex;
+        std::atomic<VkDeviceSize> frameOffset;
+    };
+
     struct UniformBufferObject
     {
         glm::mat4 ModelMatrix;
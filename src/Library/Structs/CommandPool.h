@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include "vulkan/vulkan.h"
+
+namespace vk
+{
+    struct CommandBufferList
+    {
+        std::vector<VkCommandBuffer> buffers;
+        uint32_t used;
+    };
+
+    struct ThreadCommandPool
+    {
+        VkCommandPool pool;
+        CommandBufferList primary;
+        CommandBufferList secondary;
+    };
+
+    struct FrameCommandPool
+    {
+        std::vector<ThreadCommandPool> threads;
+    };
+
+    struct CommandBufferCacheStats
+    {
+        uint64_t recorded;
+        uint64_t reused;
+    };
+
+    struct CommandBufferCache
+    {
+        VkCommandPool pool;
+        uint32_t framesCount;
+        uint32_t imagesCount;
+        std::vector<VkCommandBuffer> commandBuffers;
+        std::vector<VkFramebuffer> framebuffers;
+        std::vector<uint64_t> recordedVersions;
+        uint64_t version;
+        CommandBufferCacheStats stats;
+    };
+}
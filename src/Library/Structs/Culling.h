@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "Buffer.h"
+
+namespace vk
+{
+    enum CullingFlags
+    {
+        CULLING_INDEXED = 1,
+        CULLING_COMPACT = 2,
+        CULLING_OCCLUSION = 4
+    };
+
+    //matches the std430 layout of the instance buffer in cull.comp
+    struct CullingInstance
+    {
+        float model[16];
+        float boundingSphere[4];
+        uint32_t count;
+        uint32_t first;
+        int32_t vertexOffset;
+        uint32_t padding;
+    };
+
+    //matches the std140 layout of the parameters in cull.comp
+    struct CullingParameters
+    {
+        float viewProjection[16];
+        float pyramidViewProjection[16];
+        float frustumPlanes[6][4];
+        float pyramidSize[2];
+        uint32_t instancesCount;
+        uint32_t flags;
+    };
+
+    struct DepthPyramid
+    {
+        VkImage image;
+        VkDeviceMemory memory;
+        VkImageView view;
+        std::vector<VkImageView> levelViews;
+        VkExtent2D size;
+        uint32_t levelsCount;
+        std::vector<VkDescriptorSet> levelSets;
+        std::vector<VkDescriptorSet> depthSets;
+        bool initialized;
+        bool built;
+        float viewProjection[16];
+    };
+
+    struct GpuCulling
+    {
+        bool indexed;
+        bool compact;
+        uint32_t maxInstancesCount;
+        uint32_t instancesCount;
+        MappedBuffer instances;
+        VkBuffer drawCommands;
+        VkDeviceMemory drawCommandsMemory;
+        VkBuffer drawCount;
+        VkDeviceMemory drawCountMemory;
+        UniformRing parameters;
+        VkSampler sampler;
+        VkDescriptorPool descriptorPool;
+        VkDescriptorSetLayout cullSetLayout;
+        VkPipelineLayout cullPipelineLayout;
+        VkPipeline cullPipeline;
+        VkDescriptorSet cullSet;
+        VkDescriptorSetLayout pyramidSetLayout;
+        VkPipelineLayout pyramidPipelineLayout;
+        VkPipeline pyramidPipeline;
+        float viewProjection[16];
+        DepthPyramid pyramid;
+    };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+#include <unordered_map>
 #include "vulkan/vulkan.h"
 
 namespace vk
@@ -23,4 +25,60 @@ namespace vk
         uint32_t dstArrayElement;
         uint32_t descriptorsCount;
     };
+
+    struct DescriptorPoolRatio
+    {
+        VkDescriptorType type;
+        float descriptorsPerSet;
+    };
+
+    struct DescriptorAllocator
+    {
+        std::vector<DescriptorPoolRatio> ratios;
+        uint32_t setsPerPool;
+        std::vector<VkDescriptorPool> readyPools;
+        std::vector<VkDescriptorPool> fullPools;
+    };
+
+    struct PipelineLayoutInfo
+    {
+        std::vector<VkDescriptorSetLayout> setLayouts;
+        uint64_t pushConstantsKey;
+    };
+
+    struct DescriptorLayoutCache
+    {
+        std::unordered_map<uint64_t, VkDescriptorSetLayout> setLayouts;
+        std::unordered_map<VkDescriptorSetLayout, VkDescriptorSetLayoutCreateFlags> setLayoutFlags;
+        std::unordered_map<uint64_t, VkPipelineLayout> pipelineLayouts;
+        std::unordered_map<VkPipelineLayout, PipelineLayoutInfo> pipelineLayoutInfos;
+        std::unordered_map<VkDescriptorSetLayout, VkDescriptorUpdateTemplate> updateTemplates;
+    };
+
+    struct BoundDescriptorSets
+    {
+        VkPipelineLayout layout;
+        std::vector<VkDescriptorSet> sets;
+    };
+
+    struct DescriptorIndexingSupport
+    {
+        bool core;
+        bool supported;
+        VkPhysicalDeviceDescriptorIndexingFeatures features;
+        uint32_t maxSampledImages;
+        uint32_t maxStorageBuffers;
+        uint32_t maxPerStageResources;
+    };
+
+    struct BindlessTable
+    {
+        VkDescriptorSetLayout layout;
+        VkDescriptorPool pool;
+        VkDescriptorSet set;
+        uint32_t sampledImagesCount;
+        uint32_t storageBuffersCount;
+        std::vector<uint32_t> freeSampledImageSlots;
+        std::vector<uint32_t> freeStorageBufferSlots;
+    };
 }
\ No newline at end of file
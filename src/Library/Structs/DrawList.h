@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "Descriptors.h"
+
+namespace vk
+{
+    struct DrawMaterial
+    {
+        VkPipelineBindPoint bindPoint;
+        VkPipelineLayout layout;
+        uint32_t firstSet;
+        std::vector<VkDescriptorSet> sets;
+        std::vector<uint32_t> dynamicOffsets;
+    };
+
+    struct DrawPacket
+    {
+        uint64_t sortKey;
+        VkPipeline pipeline;
+        uint32_t material;
+        VkBuffer vertexBuffer;
+        VkDeviceSize vertexBufferOffset;
+        VkBuffer indexBuffer;
+        VkDeviceSize indexBufferOffset;
+        VkIndexType indexType;
+        VkShaderStageFlags pushConstantStages;
+        uint32_t pushConstantOffset;
+        uint32_t pushConstantSize;
+        uint32_t pushConstantData;
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t first;
+        int32_t vertexOffset;
+        uint32_t firstInstance;
+    };
+
+    struct DrawSortEntry
+    {
+        uint64_t key;
+        uint32_t packet;
+    };
+
+    struct DrawList
+    {
+        std::vector<DrawMaterial> materials;
+        std::vector<DrawPacket> packets;
+        std::vector<unsigned char> pushConstantData;
+        std::vector<DrawSortEntry> order;
+        std::vector<DrawSortEntry> sortScratch;
+    };
+
+    struct DrawRecorderStats
+    {
+        uint32_t draws;
+        uint32_t indirectDraws;
+        uint32_t pipelineBinds;
+        uint32_t pipelineBindsSkipped;
+        uint32_t descriptorBinds;
+        uint32_t descriptorBindsSkipped;
+        uint32_t vertexBufferBinds;
+        uint32_t vertexBufferBindsSkipped;
+        uint32_t indexBufferBinds;
+        uint32_t indexBufferBindsSkipped;
+        uint32_t pushConstants;
+        uint32_t pushConstantsSkipped;
+    };
+
+    struct DrawRecorder
+    {
+        VkCommandBuffer commandBuffer;
+        VkPipeline pipeline;
+        uint32_t material;
+        VkBuffer vertexBuffer;
+        VkDeviceSize vertexBufferOffset;
+        VkBuffer indexBuffer;
+        VkDeviceSize indexBufferOffset;
+        VkIndexType indexType;
+        BoundDescriptorSets boundSets;
+        VkPipelineLayout pushConstantLayout;
+        VkShaderStageFlags pushConstantStages;
+        uint32_t pushConstantOffset;
+        std::vector<unsigned char> pushConstantData;
+        DrawRecorderStats stats;
+    };
+}
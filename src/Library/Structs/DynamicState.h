@@ -0,0 +1,38 @@
+#pragma once
+
+#include "vulkan/vulkan.h"
+
+namespace vk
+{
+    struct ExtendedDynamicStateSupport
+    {
+        bool core;
+        bool extendedDynamicState;
+        bool extendedDynamicState2;
+        bool polygonMode;
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT features;
+        VkPhysicalDeviceExtendedDynamicState2FeaturesEXT features2;
+#ifdef VK_EXT_extended_dynamic_state3
+        VkPhysicalDeviceExtendedDynamicState3FeaturesEXT features3;
+#endif
+    };
+
+    struct ExtendedDynamicStateFunctions
+    {
+        PFN_vkCmdSetCullMode cmdSetCullMode;
+        PFN_vkCmdSetFrontFace cmdSetFrontFace;
+        PFN_vkCmdSetPrimitiveTopology cmdSetPrimitiveTopology;
+        PFN_vkCmdSetDepthTestEnable cmdSetDepthTestEnable;
+        PFN_vkCmdSetDepthWriteEnable cmdSetDepthWriteEnable;
+        PFN_vkCmdSetDepthCompareOp cmdSetDepthCompareOp;
+        PFN_vkCmdSetDepthBoundsTestEnable cmdSetDepthBoundsTestEnable;
+        PFN_vkCmdSetStencilTestEnable cmdSetStencilTestEnable;
+        PFN_vkCmdSetStencilOp cmdSetStencilOp;
+        PFN_vkCmdSetDepthBiasEnable cmdSetDepthBiasEnable;
+        PFN_vkCmdSetPrimitiveRestartEnable cmdSetPrimitiveRestartEnable;
+        PFN_vkCmdSetRasterizerDiscardEnable cmdSetRasterizerDiscardEnable;
+#ifdef VK_EXT_extended_dynamic_state3
+        PFN_vkCmdSetPolygonModeEXT cmdSetPolygonMode;
+#endif
+    };
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "vulkan/vulkan.h"
+
+namespace vk
+{
+    struct IndirectDrawSupport
+    {
+        bool multiDrawIndirect;
+        bool drawIndirectFirstInstance;
+        bool drawIndirectCount;
+        uint32_t maxDrawIndirectCount;
+    };
+
+    struct IndirectDrawFunctions
+    {
+        PFN_vkCmdDrawIndirectCountKHR cmdDrawIndirectCount;
+        PFN_vkCmdDrawIndexedIndirectCountKHR cmdDrawIndexedIndirectCount;
+    };
+}
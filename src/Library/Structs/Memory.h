@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include "vulkan/vulkan.h"
+
+namespace vk
+{
+    enum MemoryCategory
+    {
+        MEMORY_CATEGORY_VERTEX,
+        MEMORY_CATEGORY_INDEX,
+        MEMORY_CATEGORY_TEXTURE,
+        MEMORY_CATEGORY_UNIFORM,
+        MEMORY_CATEGORY_STAGING,
+        MEMORY_CATEGORY_ATTACHMENT,
+        MEMORY_CATEGORY_STORAGE,
+        MEMORY_CATEGORY_OTHER,
+        MEMORY_CATEGORY_COUNT
+    };
+
+    struct TrackedAllocation
+    {
+        VkDeviceSize size;
+        uint32_t memoryTypeIndex;
+        MemoryCategory category;
+    };
+
+    struct MemoryHeapStats
+    {
+        VkMemoryHeapFlags flags;
+        VkDeviceSize size;
+        VkDeviceSize trackedUsage;
+        VkDeviceSize budget;
+        VkDeviceSize usage;
+    };
+
+    struct MemoryTypeStats
+    {
+        VkMemoryPropertyFlags propertyFlags;
+        uint32_t heapIndex;
+        VkDeviceSize trackedUsage;
+        uint32_t allocationsCount;
+    };
+
+    struct MemoryStats
+    {
+        bool budgetAvailable;
+        std::vector<MemoryHeapStats> heaps;
+        std::vector<MemoryTypeStats> types;
+        VkDeviceSize categoryUsage[MEMORY_CATEGORY_COUNT];
+    };
+}
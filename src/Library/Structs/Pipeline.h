@@ -1,5 +1,8 @@
 #pragma once
 
+#include <vector>
+#include <string>
+#include <unordered_map>
 #include "vulkan/vulkan.h"
 
 namespace vk
@@ -17,4 +20,43 @@ namespace vk
         char const* entryPoint;
         VkSpecializationInfo const* specialisationInfo;
     };
-}
\ No newline at end of file
+
+    struct ShaderDefine
+    {
+        std::string name;
+        std::string value;
+    };
+
+    struct SpecializationConstants
+    {
+        std::vector<VkSpecializationMapEntry> mapEntries;
+        std::vector<unsigned char> data;
+        VkSpecializationInfo info;
+    };
+
+    struct PipelineFamily
+    {
+        VkPipeline basePipeline;
+        std::vector<VkPipeline> variants;
+    };
+
+    struct PipelineCreationTimings
+    {
+        double batchedDerivativesMs;
+        double independentMs;
+    };
+
+    struct RegisteredPipeline
+    {
+        VkPipeline pipeline;
+        uint64_t key;
+        uint64_t familyKey;
+    };
+
+    struct PipelineRegistry
+    {
+        VkPipelineCache cache;
+        std::unordered_map<uint64_t, VkPipeline> pipelines;
+        std::unordered_map<uint64_t, PipelineFamily> families;
+    };
+}
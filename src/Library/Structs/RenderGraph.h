@@ -0,0 +1,151 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include "vulkan/vulkan.h"
+
+namespace vk
+{
+    enum RenderGraphResourceType
+    {
+        RENDER_GRAPH_RESOURCE_IMAGE,
+        RENDER_GRAPH_RESOURCE_BUFFER
+    };
+
+    enum RenderGraphUsage
+    {
+        RENDER_GRAPH_USAGE_COLOR_ATTACHMENT,
+        RENDER_GRAPH_USAGE_DEPTH_ATTACHMENT,
+        RENDER_GRAPH_USAGE_DEPTH_READ_ONLY_ATTACHMENT,
+        RENDER_GRAPH_USAGE_INPUT_ATTACHMENT,
+        RENDER_GRAPH_USAGE_SAMPLED_IMAGE,
+        RENDER_GRAPH_USAGE_STORAGE_IMAGE_READ,
+        RENDER_GRAPH_USAGE_STORAGE_IMAGE_WRITE,
+        RENDER_GRAPH_USAGE_TRANSFER_SRC,
+        RENDER_GRAPH_USAGE_TRANSFER_DST,
+        RENDER_GRAPH_USAGE_UNIFORM_BUFFER,
+        RENDER_GRAPH_USAGE_STORAGE_BUFFER_READ,
+        RENDER_GRAPH_USAGE_STORAGE_BUFFER_WRITE,
+        RENDER_GRAPH_USAGE_VERTEX_BUFFER,
+        RENDER_GRAPH_USAGE_INDEX_BUFFER,
+        RENDER_GRAPH_USAGE_INDIRECT_BUFFER
+    };
+
+    struct RenderGraphImageInfo
+    {
+        VkFormat format;
+        VkExtent2D size;
+        VkSampleCountFlagBits samples;
+        VkImageAspectFlags aspect;
+    };
+
+    struct RenderGraphResourceState
+    {
+        VkImageLayout layout;
+        VkPipelineStageFlags writeStages;
+        VkAccessFlags writeAccess;
+        VkPipelineStageFlags readStages;
+        VkAccessFlags readAccess;
+        VkPipelineStageFlags transitionStages;
+        int32_t lastSubpass;
+    };
+
+    struct RenderGraphResource
+    {
+        std::string name;
+        RenderGraphResourceType type;
+        RenderGraphImageInfo imageInfo;
+        bool imported;
+        VkImage image;
+        VkImageView view;
+        VkBuffer buffer;
+        VkImageUsageFlags usage;
+        VkImageLayout initialLayout;
+        VkImageLayout finalLayout;
+        VkPipelineStageFlags initialStages;
+        VkAccessFlags initialAccess;
+        int32_t firstStep;
+        int32_t lastStep;
+        RenderGraphResourceState initialState;
+    };
+
+    struct RenderGraphAccess
+    {
+        uint32_t resource;
+        RenderGraphUsage usage;
+        VkAttachmentLoadOp loadOp;
+        VkClearValue clearValue;
+    };
+
+    struct RenderGraphResourceUse
+    {
+        uint32_t resource;
+        RenderGraphUsage usage;
+        VkPipelineStageFlags stages;
+        VkAccessFlags access;
+        VkImageLayout layout;
+        bool write;
+        bool attachment;
+        VkAttachmentLoadOp loadOp;
+        VkClearValue clearValue;
+    };
+
+    struct RenderGraphPass
+    {
+        std::string name;
+        VkPipelineBindPoint bindPoint;
+        std::vector<RenderGraphAccess> accesses;
+        std::function<void(VkCommandBuffer)> record;
+        bool sideEffect;
+        bool culled;
+        uint32_t step;
+        uint32_t subpass;
+    };
+
+    struct RenderGraphImageBarrier
+    {
+        uint32_t resource;
+        VkAccessFlags srcAccess;
+        VkAccessFlags dstAccess;
+        VkImageLayout oldLayout;
+        VkImageLayout newLayout;
+    };
+
+    struct RenderGraphBufferBarrier
+    {
+        uint32_t resource;
+        VkAccessFlags srcAccess;
+        VkAccessFlags dstAccess;
+    };
+
+    struct RenderGraphBarrier
+    {
+        VkPipelineStageFlags srcStages;
+        VkPipelineStageFlags dstStages;
+        std::vector<RenderGraphImageBarrier> images;
+        std::vector<RenderGraphBufferBarrier> buffers;
+    };
+
+    struct RenderGraphStep
+    {
+        std::vector<uint32_t> passes;
+        RenderGraphBarrier barrier;
+        VkRenderPass renderPass;
+        VkExtent2D size;
+        std::vector<uint32_t> attachments;
+        std::vector<VkClearValue> clearValues;
+        std::unordered_map<uint64_t, VkFramebuffer> framebuffers;
+    };
+
+    struct RenderGraph
+    {
+        std::vector<RenderGraphResource> resources;
+        std::vector<RenderGraphPass> passes;
+        std::vector<RenderGraphStep> steps;
+        RenderGraphBarrier finalBarrier;
+        std::vector<VkDeviceMemory> transientMemory;
+        bool compiled;
+    };
+}
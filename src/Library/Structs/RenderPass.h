@@ -2,6 +2,8 @@
 
 #include <vector>
 #include "vulkan/vulkan.h"
+#include "Descriptors.h"
+#include "CommandPool.h"
 
 namespace vk
 {
@@ -20,8 +22,9 @@ namespace vk
         VkCommandBuffer commandBuffer;
         VkSemaphore imageAcquiredSemaphore;
         VkSemaphore readyToPresentSemaphore;
-        VkFence drawingFinishedFence;
         VkImageView depthAttachment;
         VkFramebuffer framebuffer;
+        DescriptorAllocator descriptorAllocator;
+        FrameCommandPool commandPool;
     };
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+#include <functional>
 #include "vulkan/vulkan.h"
 
 namespace vk
@@ -15,4 +17,48 @@ namespace vk
         VkSemaphore Semaphore;
         VkPipelineStageFlags WaitingStage;
     };
+
+    struct TimelineSemaphoreSupport
+    {
+        bool timelineCore;
+        bool synchronization2Core;
+        bool timelineSemaphore;
+        bool synchronization2;
+        VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures;
+        VkPhysicalDeviceSynchronization2Features synchronization2Features;
+    };
+
+    struct TimelineSemaphoreFunctions
+    {
+        PFN_vkWaitSemaphores waitSemaphores;
+        PFN_vkSignalSemaphore signalSemaphore;
+        PFN_vkGetSemaphoreCounterValue getSemaphoreCounterValue;
+        PFN_vkQueueSubmit2 queueSubmit2;
+    };
+
+    struct TimelineWaitInfo
+    {
+        VkSemaphore semaphore;
+        uint64_t value;
+        VkPipelineStageFlags2 stages;
+    };
+
+    struct QueueTimeline
+    {
+        VkQueue queue;
+        uint32_t familyIndex;
+        VkSemaphore semaphore;
+        uint64_t submittedValue;
+    };
+
+    struct FrameScheduler
+    {
+        bool timeline;
+        QueueTimeline graphics;
+        QueueTimeline compute;
+        std::vector<uint64_t> frameValues;
+        std::vector<VkFence> frameFences;
+        uint64_t frameNumber;
+        uint32_t frameIndex;
+    };
 }
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <filesystem>
+#include "vulkan/vulkan.h"
+#include "Library/Structs/Pipeline.h"
+
+namespace vk
+{
+    struct WatchedShader
+    {
+        std::string sourceFile;
+        VkShaderStageFlagBits stage;
+        std::vector<ShaderDefine> defines;
+        uint32_t program;
+        VkShaderModule* module;
+        VkShaderModule latestModule;
+        std::filesystem::file_time_type lastWriteTime;
+    };
+
+    struct WatchedProgram
+    {
+        std::function<bool(const std::vector<VkShaderModule>&, std::vector<RegisteredPipeline>&)> rebuildPipelines;
+        std::vector<VkPipeline*> pipelines;
+        std::vector<size_t> shaders;
+    };
+
+    struct ShaderModuleSwap
+    {
+        VkShaderModule* target;
+        VkShaderModule module;
+    };
+
+    struct PipelineSwap
+    {
+        VkPipeline* target;
+        RegisteredPipeline pipeline;
+    };
+
+    struct RetiredPipeline
+    {
+        VkPipeline pipeline;
+        uint64_t retireValue;
+    };
+
+    struct ShaderHotReload
+    {
+        VkDevice device;
+        PipelineRegistry* registry;
+        std::string cacheDirectory;
+        std::vector<WatchedProgram> programs;
+        std::vector<WatchedShader> shaders;
+        std::mutex mutex;
+        std::vector<ShaderModuleSwap> pendingModules;
+        std::vector<PipelineSwap> pendingSwaps;
+        std::vector<RetiredPipeline> retiredPipelines;
+        std::atomic<bool> running;
+        std::thread worker;
+    };
+}